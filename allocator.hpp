@@ -7,7 +7,6 @@
 
 #include <tuple>
 #include <utilities>
-#include <stdext/array_view.hpp>
 #include <malloc>
 
 namespace stdext
@@ -7,6 +7,11 @@
 
 #include <stdext/allocator.hpp>
 #include <stdext/array_view.hpp>
+#include <stdext/sequence.hpp>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace stdext
 {
@@ -770,7 +775,9 @@ namespace stdext
 			/// All values will be rearranged into two contiguous parts which span the whole array. The
 			/// first part will contain elements which are conform with the \a predictor. The second part
 			/// will contain elements which are not conform with the \a predictor. Within each part,
-			/// every two values will have the same order as before.
+			/// every two values will have the same order as before. Non-conform values are moved aside
+			/// into an auxiliary buffer from the array's allocator; without it, the partition will be
+			/// performed in place.
 			///
 			/// @param predictor  A callable object which takes a constant reference to some value and
 			///                   returns a boolean indicating whether the value is conform with the
@@ -779,9 +786,9 @@ namespace stdext
 			/// @note Time complexity is linear with the length of the array.
 			///
 			template <Callable<bool, const T&> C>
-			constexpr std::tuple<array_view<T>, array_view<T>> partition_stable (C predictor)
+			std::tuple<array_view<T>, array_view<T>> partition_stable (C predictor)
 			{
-				return view().partition_stable(std::move(predictor));
+				return view().partition_stabely(std::move(predictor), allocator);
 			}
 
 			
@@ -915,6 +922,26 @@ namespace stdext
 				return view().sort_nth(std::move(comparer), n);
 			}
 
+			/// Multiple nth element sorting
+			///
+			/// Values will be rearranged such that the value at each index in \a indices corresponds to
+			/// the value if sorted with \a comparer. The \a indices must be in ascending order. A
+			/// bounded sequence will be returned which holds a reference for each index in \a indices,
+			/// or an empty optional container, if the index is equal or greater the array's length.
+			///
+			/// @param comparer  A callable object which takes two constant references of type \a T and
+			///                  returns a boolean indicating if both values are in right order
+			/// @param indices   Ascending indices whose values are selected
+			///
+			/// @note Average time complexity is n*log(k) with n being the length of the array and k
+			///       being the amount of indices.
+			///
+			template <Callable<bool, const T&, const T&> C>
+			constexpr auto sort_nth_many (C comparer, array_view<const std::size_t> indices)
+			{
+				return view().sort_nth_many(std::move(comparer), indices);
+			}
+
 			/// Unstable sorting
 			///
 			/// Values will be sorted according to order defined by \a comparer. The order must be strict
@@ -933,10 +960,304 @@ namespace stdext
 			}
 
 			/// Stable sorting
+			///
+			/// Values will be sorted according to order defined by \a comparer. The order must be strict
+			/// weak. Equivalent values keep their previous order. An auxiliary buffer is requested from
+			/// the array's allocator; without it, merging will be performed in place.
+			///
+			/// @param comparer  A callable object which takes two constant references of type \a T and
+			///                  returns a boolean indicating if both values are in right order
+			///
+			/// @note Time complexity is n*log(n) with n being the length of the array.
+			///
+			template <Callable<bool, const T&, const T&> C>
+			void sort_stable (C comparer)
+			{
+				view().sort_stabely(std::move(comparer), allocator);
+			}
+
+			/// Parallel unstable sorting
+			///
+			/// Values will be sorted according to order defined by \a comparer on \a threadCount
+			/// threads. An auxiliary buffer for all values is requested from the array's allocator.
+			///
+			/// @param comparer     A callable object which takes two constant references of type \a T
+			///                     and returns a boolean indicating if both values are in right order
+			/// @param threadCount  Amount of threads including the calling one
+			///
+			/// @note The header thread_pool.hpp has to be included for parallel sorting.
+			///
+			template <Callable<bool, const T&, const T&> C>
+			void sort_parallel (C comparer, std::size_t threadCount)
+			{
+				view().sort_parallel(std::move(comparer), allocator, threadCount);
+			}
+
+			/// Parallel stable sorting
+			///
+			/// Values will be stable sorted according to order defined by \a comparer on \a
+			/// threadCount threads. An auxiliary buffer for all values is requested from the array's
+			/// allocator.
+			///
+			/// @param comparer     A callable object which takes two constant references of type \a T
+			///                     and returns a boolean indicating if both values are in right order
+			/// @param threadCount  Amount of threads including the calling one
+			///
+			/// @note The header thread_pool.hpp has to be included for parallel sorting.
+			///
+			template <Callable<bool, const T&, const T&> C>
+			void sort_stable_parallel (C comparer, std::size_t threadCount)
+			{
+				view().sort_stabely_parallel(std::move(comparer), allocator, threadCount);
+			}
+
+			/// Unstable sorting by cached keys
+			///
+			/// Values will be sorted by the less-than order of the keys computed by \a extractor, with
+			/// each key computed only once. A buffer of key and index pairs is requested from the
+			/// array's allocator. See array_view::sort_by_key.
+			///
+			/// @param extractor  A callable object which takes a constant reference of type \a T and
+			///                   returns its key
+			///
+			template <Callable_<const T&> E>
+			void sort_by_key (E extractor)
+			{
+				view().sort_by_key(std::move(extractor), allocator);
+			}
+
+			/// Stable sorting by cached keys
+			///
+			/// Values will be sorted by the less-than order of the keys computed by \a extractor, and
+			/// values with equivalent keys keep their previous order. See array_view::sort_stabely_by_key.
+			///
+			/// @param extractor  A callable object which takes a constant reference of type \a T and
+			///                   returns its key
+			///
+			template <Callable_<const T&> E>
+			void sort_stable_by_key (E extractor)
+			{
+				view().sort_stabely_by_key(std::move(extractor), allocator);
+			}
+
+			/// Index sorting
+			///
+			/// An array of the indices of the values in the order defined by \a comparer will be
+			/// returned, with equivalent values ordered by their index. The values themselves are not
+			/// moved. The index array is allocated with a copy of the array's allocator.
+			///
+			/// @param comparer  A callable object which takes two constant references of type \a T and
+			///                  returns a boolean indicating if both values are in right order
+			///
+			/// @note Average time complexity is n*log(n) with n being the length of the array.
+			///
+			template <Callable<bool, const T&, const T&> C>
+			array<std::size_t, A> sort_indices (C comparer) const
+			{
+				auto indices = array<std::size_t, A>(used, allocator);
+				for (std::size_t index = 0; index < used; ++index)
+					indices.append(index);
+				view().sort_indices(std::move(comparer), indices.view());
+				return indices;
+			}
+
+			/// Permutation application
+			///
+			/// Values will be rearranged in place such that the value at each index is the value which
+			/// has been at the index given by \a indices. The \a indices will be the identity
+			/// afterwards. See array_view::apply_permutation.
+			///
+			/// @param indices  Permutation of the indices of the array
+			///
+			constexpr void apply_permutation (array_view<std::size_t> indices)
+			{
+				view().apply_permutation(indices);
+			}
+
+
+
+
+
+			// ------------------------------------------------------------------------------------------
+			// Deduplication
+
+			/// Adjacent duplicate removal
+			///
+			/// Each value which matches its kept predecessor with \a matcher will be erased. The kept
+			/// values are compacted in one pass and keep their order. If the array is sorted, each
+			/// value will be contained once afterwards.
+			///
+			/// @param matcher  A callable object which takes two constant references of type \a T and
+			///                 returns a boolean indicating whether both values are duplicates
+			///
+			/// @note Time complexity is linear in the length of the array.
+			///
+			template <Callable<bool, const T&, const T&> M>
+			constexpr void unique (M matcher)
+			{
+				const auto kept = std::get<0>(view().unique(std::move(matcher))).length();
+				destruct(data() + kept, used - kept);
+				used = kept;
+			}
+
+			/// Deduplication by sorting
+			///
+			/// The values will be sorted by \a comparer and each value will be contained once
+			/// afterwards. Values are equivalent if neither is less than the other. No memory will be
+			/// allocated.
+			///
+			/// @param comparer  A callable object which takes two constant references of type \a T and
+			///                  returns a boolean indicating if both values are in right order
+			///
+			/// @note Average time complexity is n*log(n) with n being the length of the array.
+			///
 			template <Callable<bool, const T&, const T&> C>
-			constexpr void sort_stable (C comparer)
+			constexpr void deduplicate (C comparer)
 			{
-				return view().sort_stable(std::move(comparer));
+				view().sort(comparer);
+				unique([&comparer](const T & a, const T & b){return not comparer(a, b);});
+			}
+
+			/// Deduplication by hashing
+			///
+			/// Each value which matches an earlier value with \a matcher will be erased, and the kept
+			/// values keep their order. This suits values without any order. The kept values are
+			/// found in a table of indices with open addressing, which is requested from the array's
+			/// allocator. Matching values must have equal hashes. If the table cannot be allocated,
+			/// the exception \a bad_alloc will be thrown and the array will remain unchanged. If \a
+			/// hasher or \a matcher throws, the duplicates found so far are erased, and the values
+			/// which have not been visited are kept behind the others.
+			///
+			/// @param hasher   A callable object which takes a constant reference of type \a T and
+			///                 returns its hash
+			/// @param matcher  A callable object which takes two constant references of type \a T and
+			///                 returns a boolean indicating whether both values are duplicates
+			///
+			/// @note Average time complexity is linear in the length of the array.
+			///
+			template <Callable<std::size_t, const T&> H, Callable<bool, const T&, const T&> M>
+			void deduplicate (H hasher, M matcher)
+			{
+				if (used < 2)
+					return;
+
+				auto capacity = std::size_t(1);
+				while (capacity < used * 2)
+					capacity *= 2;
+
+				auto table = allocator.template allocate<std::size_t>(capacity);
+				if (table.length() < capacity)
+				{
+					allocator.deallocate(table);
+					throw bad_alloc("deduplication table cannot be allocated");
+				}
+
+				// slots hold the index of a kept value plus one, or zero if they are free
+				std::size_t * slots = table.data();
+				for (std::size_t slot = 0; slot < capacity; ++slot)
+					slots[slot] = 0;
+
+				T * values = data();
+				const auto mask = capacity - 1;
+				auto kept = std::size_t(0);
+				auto next = std::size_t(0);
+				try
+				{
+					for (; next < used; ++next)
+					{
+						auto slot = hasher(values[next]) & mask;
+						auto duplicate = false;
+						while (slots[slot] != 0 and not duplicate)
+						{
+							duplicate = matcher(values[slots[slot] - 1], values[next]);
+							slot = (slot + 1) & mask;
+						}
+
+						if (not duplicate)
+						{
+							if (kept != next)
+								values[kept] = std::move(values[next]);
+							slots[slot] = kept + 1;
+							++kept;
+						}
+					}
+				}
+				catch (...)
+				{
+					// the unvisited values are moved down over the erased duplicates
+					allocator.deallocate(table);
+					if (kept != next)
+					{
+						for (auto index = next; index < used; ++index)
+							values[kept + index - next] = std::move(values[index]);
+						destruct(values + kept + used - next, next - kept);
+						used -= next - kept;
+					}
+					throw;
+				}
+				allocator.deallocate(table);
+
+				destruct(values + kept, used - kept);
+				used = kept;
+			}
+
+
+
+
+
+			// ------------------------------------------------------------------------------------------
+			// Searching
+
+			/// Lower bound splitting
+			///
+			/// The sorted array will be splitted into a view on all values which are less than \a
+			/// value and a view on all remaining values. The values must be sorted by \a comparer.
+			///
+			/// @note Time complexity is logarithmic in the length of the array.
+			///
+			template <Callable<bool, const T&, const T&> C>
+			constexpr std::tuple<array_view<const T>, array_view<const T>> lower_bound (C comparer, const T & value) const
+			{
+				return view().lower_bound(std::move(comparer), value);
+			}
+
+			/// Upper bound splitting
+			///
+			/// The sorted array will be splitted into a view on all values which are not greater than
+			/// \a value and a view on all remaining values. The values must be sorted by \a comparer.
+			///
+			/// @note Time complexity is logarithmic in the length of the array.
+			///
+			template <Callable<bool, const T&, const T&> C>
+			constexpr std::tuple<array_view<const T>, array_view<const T>> upper_bound (C comparer, const T & value) const
+			{
+				return view().upper_bound(std::move(comparer), value);
+			}
+
+			/// Equivalent range splitting
+			///
+			/// The sorted array will be splitted into views on the values less than, equivalent to and
+			/// greater than \a value. The values must be sorted by \a comparer.
+			///
+			/// @note Time complexity is logarithmic in the length of the array.
+			///
+			template <Callable<bool, const T&, const T&> C>
+			constexpr std::tuple<array_view<const T>, array_view<const T>, array_view<const T>> equal_range (C comparer, const T & value) const
+			{
+				return view().equal_range(std::move(comparer), value);
+			}
+
+			/// Sorted containment test
+			///
+			/// Returns whether the sorted array contains some value equivalent to \a value. The values
+			/// must be sorted by \a comparer.
+			///
+			/// @note Time complexity is logarithmic in the length of the array.
+			///
+			template <Callable<bool, const T&, const T&> C>
+			constexpr bool contains_sorted (C comparer, const T & value) const
+			{
+				return view().contains_sorted(std::move(comparer), value);
 			}
 
 	};
@@ -1842,7 +2163,229 @@ namespace stdext
 		return *this;
 	}
 
+
+	/// Builder collecting an unknown amount of values into blocks
+	///
+	/// The values are constructed into blocks from \a A whose lengths double, beginning with \a
+	/// sequenceChunkLength values. A full block is kept as it is and a new one is started, so no
+	/// value is moved while collecting. At the end, all values are moved once into an array with a
+	/// single allocation of the exact length.
+	template <typename T, Allocator A = system_allocator> class array_builder
+	{
+
+		private:
+
+			using allocation_type = allocation_type_t<A, T>;
+
+			/// Maximal amount of blocks, which together exceed any addressable memory
+			static constexpr std::size_t maxBlockCount = 48;
+
+			A allocator;
+			std::array<allocation_type, maxBlockCount> blocks;
+			std::size_t blockCount = 0;
+			std::size_t filled = 0;
+			std::size_t count = 0;
+
+
+			/// Destructs all values and deallocates all blocks
+			void release ()
+			{
+				for (std::size_t index = 0; index < blockCount; ++index)
+				{
+					const auto isLast = index + 1 == blockCount;
+					auto * values = blocks[index].data();
+					const auto length = isLast ? filled : (sequenceChunkLength << index);
+					if (not std::is_trivially_destructible<T>::value)
+					{
+						for (std::size_t position = 0; position < length; ++position)
+							values[position].~T();
+					}
+					allocator.deallocate(blocks[index]);
+				}
+				blockCount = 0;
+				filled = 0;
+				count = 0;
+			}
+
+		public:
+
+			/// Constructor with \a allocator for the blocks
+			constexpr explicit array_builder (A allocator = A())
+				noexcept(std::is_nothrow_move_constructible<A>::value)
+				: allocator(std::move(allocator))
+			{}
+
+			array_builder (const array_builder &) = delete;
+			array_builder& operator = (const array_builder &) = delete;
+
+			/// Destructor
+			///
+			/// All values which have not been moved into an array are destructed.
+			~array_builder ()
+			{
+				release();
+			}
+
+			/// Returns the amount of collected values
+			constexpr std::size_t length () const
+			{
+				return count;
+			}
+
+			/// Appends a value constructed with \a arguments
+			///
+			/// If the current block is full, a block twice as long will be allocated. If not enough
+			/// memory could be allocated, the exception \a bad_alloc will be thrown.
+			template <typename ... As>
+			void append (As && ... arguments)
+			{
+				if (blockCount == 0 or filled == (sequenceChunkLength << (blockCount - 1)))
+				{
+					assert(blockCount < maxBlockCount);
+					const auto blockLength = sequenceChunkLength << blockCount;
+					auto block = allocator.template allocate<T>(blockLength);
+					if (block.length() < blockLength)
+					{
+						allocator.deallocate(block);
+						throw bad_alloc("array builder cannot allocate block");
+					}
+					blocks[blockCount] = block;
+					++blockCount;
+					filled = 0;
+				}
+
+				new (blocks[blockCount - 1].data() + filled) T(std::forward<As>(arguments) ...);
+				++filled;
+				++count;
+			}
+
+			/// Moves all collected values to the end of \a destination
+			///
+			/// The capacity of \a destination is reserved once for all values. The builder will be
+			/// empty afterwards.
+			template <Allocator B>
+			void move_into (array<T, B> & destination)
+			{
+				destination.reserve(destination.length() + count);
+				for (std::size_t index = 0; index < blockCount; ++index)
+				{
+					const auto isLast = index + 1 == blockCount;
+					auto * values = blocks[index].data();
+					const auto length = isLast ? filled : (sequenceChunkLength << index);
+					for (std::size_t position = 0; position < length; ++position)
+						destination.append(std::move(values[position]));
+				}
+				release();
+			}
+
+			/// Returns an array with all collected values and \a allocator
+			///
+			/// The array is allocated once with the exact length. The builder will be empty
+			/// afterwards.
+			template <Allocator B>
+			array<T, B> build (B allocator)
+			{
+				auto values = array<T, B>(std::move(allocator));
+				move_into(values);
+				return values;
+			}
+	};
+
+
+
+	/// Collects all elements of \a sequence into an array with \a allocator
+	///
+	/// The strategy depends on the kind of \a sequence. The length of an indexed sequence is known
+	/// in constant time, so the array is allocated once with the exact length and filled in a
+	/// single pass. All other sequences are traversed once into an array builder, whose blocks are
+	/// allocated from a copy of \a allocator and moved into a single allocation of the exact
+	/// length at the end. In contrast to constructing an array from a sequence, no sequence is
+	/// traversed twice for its length, and no value is moved by repeated growth.
+	///
+	/// @param sequence   Bounded sequence whose elements are collected
+	/// @param allocator  Allocator of the array
+	///
+	/// @note If not enough memory could be allocated, the exception \a bad_alloc will be thrown.
+	///
+	template <Allocator A = system_allocator, BoundedSequence S>
+	array<std::decay_t<sequence_type_t<S>>, A> collect (S sequence, A allocator = A())
+	{
+		using T = std::decay_t<sequence_type_t<S>>;
+
+		if constexpr (IndexedBoundedSequence<S>)
+		{
+			auto values = array<T, A>(std::move(allocator));
+			values.reserve(sequence.length());
+			sequence.fold([&values](std::size_t count, auto && element)
+			{
+				values.append(std::forward<decltype(element)>(element));
+				return count + 1;
+			}, std::size_t(0));
+			return values;
+		}
+		else
+		{
+			auto builder = array_builder<T, A>(allocator);
+			sequence.fold([&builder](std::size_t count, auto && element)
+			{
+				builder.append(std::forward<decltype(element)>(element));
+				return count + 1;
+			}, std::size_t(0));
+			return builder.build(std::move(allocator));
+		}
+	}
+
+	/// Collects all elements of \a sequence to the end of \a destination
+	///
+	/// The capacity of \a destination is reserved once for all elements, like with collecting into
+	/// a new array. The blocks for sequences without a known length are allocated from \a
+	/// scratch.
+	template <Allocator B = system_allocator, BoundedSequence S, typename T, Allocator A>
+	void collect (S sequence, array<T, A> & destination, B scratch = B())
+	{
+		if constexpr (IndexedBoundedSequence<S>)
+		{
+			destination.reserve(destination.length() + sequence.length());
+			sequence.fold([&destination](std::size_t count, auto && element)
+			{
+				destination.append(std::forward<decltype(element)>(element));
+				return count + 1;
+			}, std::size_t(0));
+		}
+		else
+		{
+			auto builder = array_builder<T, B>(std::move(scratch));
+			sequence.fold([&builder](std::size_t count, auto && element)
+			{
+				builder.append(std::forward<decltype(element)>(element));
+				return count + 1;
+			}, std::size_t(0));
+			builder.move_into(destination);
+		}
+	}
+
+	/// Collects elements of \a sequence into the caller provided \a storage
+	///
+	/// The values of \a storage are assigned one by one until it is full or \a sequence ends, so
+	/// nothing is allocated. The view of the assigned values will be returned along with the
+	/// sequence of the elements which did not fit.
+	template <BoundedSequence S, typename T>
+	std::tuple<array_view<T>, S> collect (S sequence, array_view<T> storage)
+	{
+		static_assert(not std::is_const<T>::value, "Storage must be mutable!");
+
+		const auto capacity = storage.length();
+		auto * values = storage.data();
+		auto folding = sequence.fold([capacity, values](std::size_t count, auto && element)
+		{
+			const auto isInBound = count < capacity;
+			if (isInBound)
+				values[count] = std::forward<decltype(element)>(element);
+			return std::make_tuple(count + (isInBound ? 1 : 0), isInBound);
+		}, std::size_t(0));
+		return std::make_tuple(std::get<0>(storage.split(std::get<0>(folding))), std::move(std::get<2>(folding)));
+	}
+
 }
 
 #endif
-
@@ -8,12 +8,20 @@
 #include <stdext/callable.hpp>
 #include <stdext/sequence.hpp>
 #include <stdext/optional.hpp>
+#include <stdext/allocator.hpp>
+#include <stdext/sorting_network.hpp>
 #include <tuple>
 #include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace stdext
 {
 
+	class thread_pool;
+
 	/// View on an arbitrary array
 	///
 	/// The view on an array is a lightweighted object which does not manage the underlying memory
@@ -49,6 +57,28 @@ namespace stdext
 			}
 		}
 
+		/// Sorts small ranges from index \a begin to \a end
+		///
+		/// Arithmetic values compared with their less-than operator are sorted by a sorting network,
+		/// if the range is not longer than \a maxSortingNetworkLength. Otherwise they are insertion
+		/// sorted.
+		template <Callable<bool, const T&, const T&> C>
+		constexpr void small_sort (C & comparer, std::size_t begin, std::size_t end)
+		{
+			assert(begin <= end);
+			assert(end <= length);
+
+			if constexpr (is_sorting_network_applicable_v<T, C>)
+			{
+				if (end - begin <= maxSortingNetworkLength)
+				{
+					sort_by_network(values + begin, end - begin);
+					return;
+				}
+			}
+			insertion_sort(comparer, begin, end);
+		}
+
 		/// Reverts values from \a begin to \a end
 		constexpr void reverse (std::size_t begin, std::size_t end)
 		{
@@ -62,27 +92,187 @@ namespace stdext
 			}
 		}
 
-		/// Rotates values from \a begin to \a end \a count times
+		/// Size in bytes of the stack buffer for rotations
+		static constexpr std::size_t rotationBufferSize = 512;
+
+		/// Size in bytes up to which ranges of small trivially copyable values are rotated by
+		/// triple reversal
+		static constexpr std::size_t rotationReversalSize = 32768;
+
+		/// Swaps the \a count values starting at \a first with the \a count values starting at \a
+		/// second
+		constexpr void swap_blocks (std::size_t first, std::size_t second, std::size_t count)
+		{
+			assert(first + count <= second or second + count <= first);
+			assert(first + count <= length);
+			assert(second + count <= length);
+
+			using std::swap;
+			for (std::size_t index = 0; index < count; ++index)
+				swap(values[first + index], values[second + index]);
+		}
+
+		/// Rotates values from \a begin to \a end by moving the shorter part through a buffer on
+		/// the stack
+		///
+		/// The shorter part must fit into \a rotationBufferSize bytes. Trivially copyable values are
+		/// moved by memory copies, all others are moved one by one.
+		void rotate_buffered (std::size_t begin, std::size_t end, std::size_t middle)
+		{
+			assert(begin < middle);
+			assert(middle < end);
+			assert(end <= length);
+
+			const auto left = middle - begin;
+			const auto right = end - middle;
+			alignas(T) unsigned char storage[rotationBufferSize];
+			auto buffer = reinterpret_cast<T*>(storage);
+
+			if constexpr (std::is_trivially_copyable<T>::value)
+			{
+				if (left <= right)
+				{
+					std::memcpy(buffer, values + begin, left * sizeof(T));
+					std::memmove(values + begin, values + middle, right * sizeof(T));
+					std::memcpy(values + begin + right, buffer, left * sizeof(T));
+				}
+				else
+				{
+					std::memcpy(buffer, values + middle, right * sizeof(T));
+					std::memmove(values + begin + right, values + begin, left * sizeof(T));
+					std::memcpy(values + begin, buffer, right * sizeof(T));
+				}
+			}
+			else if (left <= right)
+			{
+				for (std::size_t index = 0; index < left; ++index)
+					new (buffer + index) T(std::move(values[begin + index]));
+				for (std::size_t index = 0; index < right; ++index)
+					values[begin + index] = std::move(values[middle + index]);
+				for (std::size_t index = 0; index < left; ++index)
+				{
+					values[begin + right + index] = std::move(buffer[index]);
+					buffer[index].~T();
+				}
+			}
+			else
+			{
+				for (std::size_t index = 0; index < right; ++index)
+					new (buffer + index) T(std::move(values[middle + index]));
+				for (auto index = left; index > 0; --index)
+					values[begin + right + index - 1] = std::move(values[begin + index - 1]);
+				for (std::size_t index = 0; index < right; ++index)
+				{
+					values[begin + index] = std::move(buffer[index]);
+					buffer[index].~T();
+				}
+			}
+		}
+
+		/// Rotates values from \a begin to \a end such that the value at \a middle becomes the first
+		///
+		/// If the shorter part fits into a small buffer, it will be moved aside and the longer part
+		/// will be shifted in one pass. Ranges of small trivially copyable values which fit into the
+		/// cache are rotated by triple reversal, whose simple loops vectorise well. All other ranges
+		/// are reduced by Gries-Mills block swaps, which stream forward through memory and swap
+		/// each value at most once into its final place, until the shorter part fits the buffer.
 		constexpr void rotate (std::size_t begin, std::size_t end, std::size_t middle)
 		{
 			assert(begin <= middle);
 			assert(middle <= end);
 			assert(end <= length);
 
-			const auto _length = end - begin;
-			const auto count  = middle - begin;
-			if ((end - begin) > 1 and middle > begin and end > middle)
+			constexpr auto bufferLength = rotationBufferSize / sizeof(T);
+			constexpr auto isReversible = std::is_trivially_copyable<T>::value and sizeof(T) <= 2 * sizeof(void*);
+
+			while (begin < middle and middle < end)
 			{
-				auto next = middle;
-				while (next != begin)
+				const auto left = middle - begin;
+				const auto right = end - middle;
+
+				if (left <= bufferLength or right <= bufferLength)
 				{
-					swap(values[begin], values[next]);
-					++begin;
-					++next;
-					if (next == end) next = middle;
-					else if (begin == middle) middle = next;
+					rotate_buffered(begin, end, middle);
+					return;
 				}
+				else if (isReversible and (end - begin) * sizeof(T) <= rotationReversalSize)
+				{
+					reverse(begin, middle);
+					reverse(middle, end);
+					reverse(begin, end);
+					return;
+				}
+				else if (left <= right)
+				{
+					// the first part swaps with the next values, which are then in place
+					swap_blocks(begin, middle, left);
+					begin = middle;
+					middle = middle + left;
+				}
+				else
+				{
+					// the second part swaps with the last values of the first part, which are then in place
+					swap_blocks(middle - right, middle, right);
+					end = middle;
+					middle = middle - right;
+				}
+			}
+		}
+
+		/// Hints the processor to fetch the cache line at \a address
+		static constexpr void prefetch (const T * address)
+		{
+#if defined(__GNUC__)
+			__builtin_prefetch(address);
+#else
+			(void)address;
+#endif
+		}
+
+		/// Returns the index of the first value which is not less than \a value
+		///
+		/// The values must be sorted by \a comparer. The search halves the range without any
+		/// branch depending on the comparison, so no branch will be mispredicted. Both possible
+		/// succeeding probes are prefetched.
+		template <Callable<bool, const T&, const T&> C>
+		constexpr std::size_t lower_bound_index (C & comparer, const T & value) const
+		{
+			if (length == 0)
+				return 0;
+
+			const T * base = values;
+			auto count = length;
+			while (count > 1)
+			{
+				const auto half = count / 2;
+				prefetch(base + (count - half) / 2);
+				prefetch(base + half + (count - half) / 2);
+				base += comparer(base[half], value) ? half : 0;
+				count -= half;
+			}
+			return (base - values) + (comparer(*base, value) ? 1 : 0);
+		}
+
+		/// Returns the index of the first value which is greater than \a value
+		///
+		/// The values must be sorted by \a comparer. The search works like \a lower_bound_index.
+		template <Callable<bool, const T&, const T&> C>
+		constexpr std::size_t upper_bound_index (C & comparer, const T & value) const
+		{
+			if (length == 0)
+				return 0;
+
+			const T * base = values;
+			auto count = length;
+			while (count > 1)
+			{
+				const auto half = count / 2;
+				prefetch(base + (count - half) / 2);
+				prefetch(base + half + (count - half) / 2);
+				base += comparer(value, base[half]) ? 0 : half;
+				count -= half;
 			}
+			return (base - values) + (comparer(value, *base) ? 0 : 1);
 		}
 
 		/// Get median index of three values at indices \a a, \a b and \a c
@@ -281,47 +471,79 @@ namespace stdext
 			insertion_sort(comparer, begin, end);
 		}
 
-
+		/// Multiple selection
+		///
+		/// The values from \a begin to \a end will be rearranged such that each of the \a count
+		/// ascending \a ranks holds the value it would hold if sorted with \a comparer. After each
+		/// partitioning, only the partitions containing some rank will be partitioned further, so
+		/// the costs grow with the logarithm of the amount of ranks instead of linearly. After \a
+		/// limit partitionings, the remaining range will be sorted.
 		template <Callable<bool, const T&, const T&> C>
-		constexpr void intro_sort (C comparer, std::size_t begin, std::size_t end, std::size_t limit, std::size_t minLength)
+		constexpr void intro_select_many (C & comparer, std::size_t begin, std::size_t end, const std::size_t * ranks, std::size_t count, std::size_t limit)
 		{
 			assert(begin <= end);
 			assert(end <= length);
+			assert(count == 0 or (begin <= ranks[0] and ranks[count-1] < end));
 
-			while (end - begin > minLength)
+			while (count > 0 and end - begin > 3)
 			{
 				if (limit == 0)
 				{
-					const auto rev_comparer = [&](const auto & a, const auto & b){return comparer(b, a);};
-					build_heap(rev_comparer, begin, end);
-					pop_heap(rev_comparer, begin, end);
+					array_view(values + begin, end - begin).sort(comparer);
+					return;
+				}
+
+				--limit;
+				const auto cut = partition_randomly(comparer, begin, end);
+				auto split = std::size_t(0);
+				while (split < count and ranks[split] < cut)
+					++split;
+
+				// recurse into the partition with fewer ranks and loop on the other one
+				if (split < count - split)
+				{
+					intro_select_many(comparer, begin, cut, ranks, split, limit);
+					ranks += split;
+					count -= split;
+					begin = cut;
 				}
 				else
 				{
-					--limit;
-					const auto cut = partition_randomly(comparer, begin, end);
-					intro_sort(comparer, begin, end, limit, minLength);
+					intro_select_many(comparer, cut, end, ranks + split, count - split, limit);
+					count = split;
 					end = cut;
 				}
 			}
+
+			if (count > 0)
+				insertion_sort(comparer, begin, end);
 		}
 
 
 		template <Callable<bool, const T&, const T&> C>
-		constexpr void merge_sort (C comparer, std::size_t begin, std::size_t end, std::size_t minLength)
+		constexpr void intro_sort (C comparer, std::size_t begin, std::size_t end, std::size_t limit, std::size_t minLength)
 		{
-			if (end - begin > minLength)
-			{
-				const auto middle = begin + (end - begin) / 2;
-				merge_sort(comparer, begin, middle, minLength);
-				merge_sort(comparer, middle, end, minLength);
-				merge_sorted(comparer, begin, middle, end);
-				sort_merge_inplace(comparer, begin, middle, end);
-			}
-			else
+			assert(begin <= end);
+			assert(end <= length);
+
+			while (end - begin > minLength)
 			{
-				insertion_sort(comparer, begin, end);
+				if (limit == 0)
+				{
+					const auto rev_comparer = [&](const auto & a, const auto & b){return comparer(b, a);};
+					build_heap(rev_comparer, begin, end);
+					pop_total_heap(rev_comparer, begin, end);
+					return;
+				}
+				else
+				{
+					--limit;
+					const auto cut = partition_randomly(comparer, begin, end);
+					intro_sort(comparer, cut, end, limit, minLength);
+					end = cut;
+				}
 			}
+			small_sort(comparer, begin, end);
 		}
 
 
@@ -391,6 +613,639 @@ namespace stdext
 		}
 
 
+		/// Counts the natural run starting at \a begin
+		///
+		/// The run ends before \a end or with the first value which breaks the order given by \a
+		/// comparer. A strictly descending run will be reversed in place, so the returning run is
+		/// always ascending. Strictness keeps equivalent values in their original order.
+		template <Callable<bool, const T&, const T&> C>
+		constexpr std::size_t count_run (C & comparer, std::size_t begin, std::size_t end)
+		{
+			assert(begin < end);
+			assert(end <= length);
+
+			auto next = begin + 1;
+			if (next < end and comparer(values[next], values[begin]))
+			{
+				while (next < end and comparer(values[next], values[next-1]))
+					++next;
+				reverse(begin, next);
+			}
+			else
+			{
+				while (next < end and not comparer(values[next], values[next-1]))
+					++next;
+			}
+			return next - begin;
+		}
+
+		/// Binary insertion sorts values from \a sorted to \a end into the sorted values from \a
+		/// begin to \a sorted
+		///
+		/// Each value is placed behind all its equivalents, so the sorting is stable.
+		template <Callable<bool, const T&, const T&> C>
+		constexpr void insertion_sort_binary (C & comparer, std::size_t begin, std::size_t sorted, std::size_t end)
+		{
+			assert(begin <= sorted);
+			assert(sorted <= end);
+			assert(end <= length);
+
+			for (auto nextToSort = sorted; nextToSort < end; ++nextToSort)
+			{
+				const auto bound = begin + gallop([&](std::size_t index)
+				{
+					return not comparer(values[nextToSort], values[begin + index]);
+				}, nextToSort - begin, true);
+
+				if (bound < nextToSort)
+				{
+					auto tmp = std::move(values[nextToSort]);
+					for (auto index = nextToSort; index > bound; --index)
+						values[index] = std::move(values[index-1]);
+					values[bound] = std::move(tmp);
+				}
+			}
+		}
+
+		/// Extends the sorted run from \a begin to \a sorted with the values up to \a end
+		///
+		/// Runs of integers compared with their less-than operator are sorted by a sorting network,
+		/// if they are not longer than \a maxSortingNetworkLength. Equivalent integers are equal,
+		/// so the order among them cannot be observed. All other runs are extended by binary
+		/// insertion sort.
+		template <Callable<bool, const T&, const T&> C>
+		constexpr void extend_run (C & comparer, std::size_t begin, std::size_t sorted, std::size_t end)
+		{
+			if constexpr (std::is_integral<T>::value and is_sorting_network_applicable_v<T, C>)
+			{
+				if (end - begin <= maxSortingNetworkLength)
+				{
+					sort_by_network(values + begin, end - begin);
+					return;
+				}
+			}
+			insertion_sort_binary(comparer, begin, sorted, end);
+		}
+
+		/// Counts the leading indices from zero to \a count for which \a predictor holds
+		///
+		/// The \a predictor must hold for a prefix and must not hold for the suffix of the indices.
+		/// The boundary is searched exponentially from the front or, if \a reversed, from the back
+		/// and then refined by a binary search. Searching from the expected side of the boundary
+		/// keeps the costs logarithmic in the distance to that side.
+		template <Callable<bool, std::size_t> P>
+		static constexpr std::size_t gallop (P predictor, std::size_t count, bool reversed)
+		{
+			auto lower = std::size_t(0);
+			auto upper = count;
+			auto step = std::size_t(1);
+
+			if (not reversed)
+			{
+				while (step <= count and predictor(step - 1))
+				{
+					lower = step;
+					step = step * 2;
+				}
+				if (step <= count)
+					upper = step - 1;
+			}
+			else
+			{
+				while (step <= count and not predictor(count - step))
+				{
+					upper = count - step;
+					step = step * 2;
+				}
+				if (step <= count)
+					lower = count - step + 1;
+			}
+
+			while (lower < upper)
+			{
+				const auto middle = lower + (upper - lower) / 2;
+				if (predictor(middle)) lower = middle + 1;
+				else                   upper = middle;
+			}
+			return lower;
+		}
+
+		/// Merges the sorted values from \a begin to \a middle with the sorted values from \a middle
+		/// to \a end by moving the first part into \a buffer
+		///
+		/// The \a buffer must provide uninitialised storage for \a middle - \a begin values.
+		/// Merging starts at the front. If one part wins often enough in a row, merging switches to
+		/// galloping which moves whole blocks at once. The galloping threshold adapts on how well
+		/// galloping pays off.
+		template <Callable<bool, const T&, const T&> C>
+		void merge_low (C & comparer, std::size_t begin, std::size_t middle, std::size_t end, T * buffer)
+		{
+			assert(begin < middle);
+			assert(middle < end);
+			assert(end <= length);
+			assert(buffer != nullptr);
+
+			const auto count = middle - begin;
+			for (std::size_t index = 0; index < count; ++index)
+				new (buffer + index) T(std::move(values[begin + index]));
+
+			auto target = begin;
+			auto left = std::size_t(0);
+			auto right = middle;
+			auto minGallop = std::size_t(7);
+
+			while (left < count and right < end)
+			{
+				// merge one value after another until one part wins constantly
+				auto leftWins = std::size_t(0);
+				auto rightWins = std::size_t(0);
+				while (left < count and right < end and leftWins < minGallop and rightWins < minGallop)
+				{
+					if (comparer(values[right], buffer[left]))
+					{
+						values[target++] = std::move(values[right++]);
+						++rightWins;
+						leftWins = 0;
+					}
+					else
+					{
+						values[target++] = std::move(buffer[left++]);
+						++leftWins;
+						rightWins = 0;
+					}
+				}
+
+				// gallop as long as it moves big enough blocks
+				auto keepGalloping = left < count and right < end;
+				while (keepGalloping)
+				{
+					leftWins = gallop([&](std::size_t index)
+					{
+						return not comparer(values[right], buffer[left + index]);
+					}, count - left, false);
+					for (auto index = left + leftWins; left < index; )
+						values[target++] = std::move(buffer[left++]);
+					if (left == count) break;
+
+					values[target++] = std::move(values[right++]);
+					if (right == end) break;
+
+					rightWins = gallop([&](std::size_t index)
+					{
+						return comparer(values[right + index], buffer[left]);
+					}, end - right, false);
+					for (auto index = right + rightWins; right < index; )
+						values[target++] = std::move(values[right++]);
+					if (right == end) break;
+
+					values[target++] = std::move(buffer[left++]);
+					if (left == count) break;
+
+					if (minGallop > 1) --minGallop;
+					keepGalloping = leftWins >= 7 or rightWins >= 7;
+				}
+				minGallop += 2;
+			}
+
+			// remaining values of the second part are already in place
+			while (left < count)
+				values[target++] = std::move(buffer[left++]);
+
+			for (std::size_t index = 0; index < count; ++index)
+				buffer[index].~T();
+		}
+
+		/// Merges the sorted values from \a begin to \a middle with the sorted values from \a middle
+		/// to \a end by moving the second part into \a buffer
+		///
+		/// The \a buffer must provide uninitialised storage for \a end - \a middle values. Merging
+		/// starts at the back and gallops like \a merge_low.
+		template <Callable<bool, const T&, const T&> C>
+		void merge_high (C & comparer, std::size_t begin, std::size_t middle, std::size_t end, T * buffer)
+		{
+			assert(begin < middle);
+			assert(middle < end);
+			assert(end <= length);
+			assert(buffer != nullptr);
+
+			const auto count = end - middle;
+			for (std::size_t index = 0; index < count; ++index)
+				new (buffer + index) T(std::move(values[middle + index]));
+
+			auto target = end;
+			auto left = middle;
+			auto right = count;
+			auto minGallop = std::size_t(7);
+
+			while (left > begin and right > 0)
+			{
+				// merge one value after another until one part wins constantly
+				auto leftWins = std::size_t(0);
+				auto rightWins = std::size_t(0);
+				while (left > begin and right > 0 and leftWins < minGallop and rightWins < minGallop)
+				{
+					if (comparer(buffer[right-1], values[left-1]))
+					{
+						values[--target] = std::move(values[--left]);
+						++leftWins;
+						rightWins = 0;
+					}
+					else
+					{
+						values[--target] = std::move(buffer[--right]);
+						++rightWins;
+						leftWins = 0;
+					}
+				}
+
+				// gallop as long as it moves big enough blocks
+				auto keepGalloping = left > begin and right > 0;
+				while (keepGalloping)
+				{
+					leftWins = (left - begin) - gallop([&](std::size_t index)
+					{
+						return not comparer(buffer[right-1], values[begin + index]);
+					}, left - begin, true);
+					for (auto index = left - leftWins; index < left; )
+						values[--target] = std::move(values[--left]);
+					if (left == begin) break;
+
+					values[--target] = std::move(buffer[--right]);
+					if (right == 0) break;
+
+					rightWins = right - gallop([&](std::size_t index)
+					{
+						return comparer(buffer[index], values[left-1]);
+					}, right, true);
+					for (auto index = right - rightWins; index < right; )
+						values[--target] = std::move(buffer[--right]);
+					if (right == 0) break;
+
+					values[--target] = std::move(values[--left]);
+					if (left == begin) break;
+
+					if (minGallop > 1) --minGallop;
+					keepGalloping = leftWins >= 7 or rightWins >= 7;
+				}
+				minGallop += 2;
+			}
+
+			// remaining values of the first part are already in place
+			while (right > 0)
+				values[--target] = std::move(buffer[--right]);
+
+			for (std::size_t index = 0; index < count; ++index)
+				buffer[index].~T();
+		}
+
+		/// Merges the sorted values from \a begin to \a middle with the sorted values from \a middle
+		/// to \a end with help of \a buffer
+		///
+		/// Values already in place at the front of the first part and at the back of the second part
+		/// are skipped. The shorter of the remaining parts will be moved into \a buffer, which
+		/// provides uninitialised storage for \a capacity values. If the \a buffer is too small,
+		/// merging falls back to \a sort_merge_inplace.
+		template <Callable<bool, const T&, const T&> C>
+		void merge_buffered (C & comparer, std::size_t begin, std::size_t middle, std::size_t end, T * buffer, std::size_t capacity)
+		{
+			assert(begin <= middle);
+			assert(middle <= end);
+			assert(end <= length);
+
+			if (begin == middle or middle == end)
+				return;
+
+			begin = begin + gallop([&](std::size_t index)
+			{
+				return not comparer(values[middle], values[begin + index]);
+			}, middle - begin, false);
+			if (begin == middle)
+				return;
+
+			end = middle + gallop([&](std::size_t index)
+			{
+				return comparer(values[middle + index], values[middle-1]);
+			}, end - middle, true);
+			if (middle == end)
+				return;
+
+			if (middle - begin <= end - middle and middle - begin <= capacity)
+				merge_low(comparer, begin, middle, end, buffer);
+			else if (end - middle < middle - begin and end - middle <= capacity)
+				merge_high(comparer, begin, middle, end, buffer);
+			else
+				sort_merge_inplace(comparer, begin, middle, end);
+		}
+
+		/// Returns the power of the boundary between two neighbouring runs
+		///
+		/// The first run starts at \a begin and has \a first values, the second run directly follows
+		/// with \a second values. All runs span \a count values. The power is the depth of the
+		/// boundary in a nearly optimal merge tree.
+		static constexpr std::size_t run_power (std::size_t begin, std::size_t first, std::size_t second, std::size_t count)
+		{
+			auto a = 2 * begin + first;
+			auto b = a + first + second;
+			auto power = std::size_t(0);
+			while (true)
+			{
+				++power;
+				if (a >= count)
+				{
+					a -= count;
+					b -= count;
+				}
+				else if (b >= count)
+				{
+					return power;
+				}
+				a = a * 2;
+				b = b * 2;
+			}
+		}
+
+		/// Returns the minimal run length for \a count values
+		///
+		/// The minimal length lies between 32 and 64 such that \a count divided by it is close to but
+		/// not more than a power of two.
+		static constexpr std::size_t min_run_length (std::size_t count)
+		{
+			auto remainder = std::size_t(0);
+			while (count >= 64)
+			{
+				remainder = remainder | (count & 1);
+				count = count / 2;
+			}
+			return count + remainder;
+		}
+
+		/// Stable sorting with natural runs and an auxiliary \a buffer
+		///
+		/// The natural runs will be detected and extended to a minimal length by extend_run. Runs
+		/// are merged in the order given by the powersort policy, so all merges together move
+		/// nearly optimally few values. The \a buffer provides uninitialised storage for \a
+		/// capacity values; half the length of the view is sufficient for all merges.
+		template <Callable<bool, const T&, const T&> C>
+		void merge_sort_buffered (C & comparer, T * buffer, std::size_t capacity)
+		{
+			assert(buffer != nullptr or capacity == 0);
+
+			// runs on the stack have strictly increasing powers, so 64 entries suffice
+			std::size_t runBegins[65];
+			std::size_t runPowers[65];
+			std::size_t runCount = 0;
+
+			const auto minRunLength = min_run_length(length);
+			auto begin = std::size_t(0);
+			auto end = begin + count_run(comparer, begin, length);
+			if (end - begin < minRunLength)
+			{
+				const auto forcedEnd = begin + minRunLength < length ? begin + minRunLength : length;
+				extend_run(comparer, begin, end, forcedEnd);
+				end = forcedEnd;
+			}
+
+			while (end < length)
+			{
+				auto nextEnd = end + count_run(comparer, end, length);
+				if (nextEnd - end < minRunLength)
+				{
+					const auto forcedEnd = end + minRunLength < length ? end + minRunLength : length;
+					extend_run(comparer, end, nextEnd, forcedEnd);
+					nextEnd = forcedEnd;
+				}
+
+				const auto power = run_power(begin, end - begin, nextEnd - end, length);
+				while (runCount > 0 and runPowers[runCount-1] > power)
+				{
+					--runCount;
+					merge_buffered(comparer, runBegins[runCount], begin, end, buffer, capacity);
+					begin = runBegins[runCount];
+				}
+
+				runBegins[runCount] = begin;
+				runPowers[runCount] = power;
+				++runCount;
+				begin = end;
+				end = nextEnd;
+			}
+
+			while (runCount > 0)
+			{
+				--runCount;
+				merge_buffered(comparer, runBegins[runCount], begin, end, buffer, capacity);
+				begin = runBegins[runCount];
+			}
+		}
+
+		/// Counts how many values of \a first belong to the first \a count values when merging the
+		/// sorted \a first values with the sorted \a second values
+		///
+		/// Values of \a first precede equivalent values of \a second, so the split is consistent
+		/// with a stable merge.
+		template <Callable<bool, const T&, const T&> C>
+		static std::size_t merge_rank (C & comparer, const T * first, std::size_t firstCount, const T * second, std::size_t secondCount, std::size_t count)
+		{
+			assert(count <= firstCount + secondCount);
+
+			auto lower = count > secondCount ? count - secondCount : 0;
+			auto upper = count < firstCount ? count : firstCount;
+			while (lower < upper)
+			{
+				const auto middle = lower + (upper - lower) / 2;
+				if (not comparer(second[count - middle - 1], first[middle])) lower = middle + 1;
+				else                                                        upper = middle;
+			}
+			return lower;
+		}
+
+		/// Stable merges \a firstCount values from \a first with \a secondCount values from \a
+		/// second into \a target by move assignment
+		template <Callable<bool, const T&, const T&> C>
+		static void merge_into (C & comparer, T * first, std::size_t firstCount, T * second, std::size_t secondCount, T * target)
+		{
+			auto place = [&](T & value)
+			{
+				*target = std::move(value);
+				++target;
+			};
+
+			auto left = std::size_t(0);
+			auto right = std::size_t(0);
+			while (left < firstCount and right < secondCount)
+			{
+				if (comparer(second[right], first[left])) place(second[right++]);
+				else                                      place(first[left++]);
+			}
+			while (left < firstCount)
+				place(first[left++]);
+			while (right < secondCount)
+				place(second[right++]);
+		}
+
+		/// Waits for all jobs of \a pool before an exception is passed on
+		///
+		/// Jobs submitted before a failing submission may still run. Exceptions of jobs are
+		/// discarded in favour of the exception being passed on.
+		template <typename P>
+		static void finish_jobs (P & pool) noexcept
+		{
+			try
+			{
+				pool.wait();
+			}
+			catch (...)
+			{}
+		}
+
+		/// Merges sorted chunks of \a chunkLength values in parallel rounds
+		///
+		/// The values are moved into \a buffer, which provides uninitialised storage for all
+		/// values, before the first round. Each round merges neighbouring pairs of sorted ranges
+		/// into the other storage, either the view or \a buffer. Every merge is split by \a
+		/// merge_rank into pieces of about \a grain values, so all threads of \a pool stay busy
+		/// even in the last round. Eventually, all values are back in the view and the \a buffer
+		/// is uninitialised again, also if \a comparer throws.
+		template <Callable<bool, const T&, const T&> C, typename P>
+		void merge_chunks_parallel (C & comparer, P & pool, T * buffer, std::size_t chunkLength, std::size_t grain)
+		{
+			assert(buffer != nullptr);
+			assert(chunkLength > 0);
+			assert(grain > 0);
+
+			// moving is nothrow, so all submitted parts are constructed after waiting
+			auto submitted = std::size_t(0);
+			try
+			{
+				while (submitted < length)
+				{
+					const auto begin = submitted;
+					const auto end = grain < length - begin ? begin + grain : length;
+					pool.submit([this, buffer, begin, end]()
+					{
+						for (auto index = begin; index < end; ++index)
+							new (buffer + index) T(std::move(values[index]));
+					});
+					submitted = end;
+				}
+			}
+			catch (...)
+			{
+				finish_jobs(pool);
+				for (std::size_t index = 0; index < submitted; ++index)
+				{
+					values[index] = std::move(buffer[index]);
+					buffer[index].~T();
+				}
+				throw;
+			}
+			pool.wait();
+
+			auto source = buffer;
+			auto target = values;
+			try
+			{
+				for (auto width = chunkLength; width < length or source != values; width = width * 2)
+				{
+					// all values are sorted but placed in the buffer, so the last round just moves back
+					for (std::size_t begin = 0; begin < length; begin += 2 * width)
+					{
+						const auto middle = width < length - begin ? begin + width : length;
+						const auto end = width < length - middle ? middle + width : length;
+						const auto pieceCount = (end - begin + grain - 1) / grain;
+						for (std::size_t piece = 0; piece < pieceCount; ++piece)
+						{
+							pool.submit([=, &comparer]()
+							{
+								const auto first = source + begin;
+								const auto firstCount = middle - begin;
+								const auto second = source + middle;
+								const auto secondCount = end - middle;
+								const auto pieceBegin = (end - begin) * piece / pieceCount;
+								const auto pieceEnd = (end - begin) * (piece + 1) / pieceCount;
+								const auto leftBegin = merge_rank(comparer, first, firstCount, second, secondCount, pieceBegin);
+								const auto leftEnd = merge_rank(comparer, first, firstCount, second, secondCount, pieceEnd);
+								const auto rightBegin = pieceBegin - leftBegin;
+								const auto rightEnd = pieceEnd - leftEnd;
+								merge_into(comparer, first + leftBegin, leftEnd - leftBegin, second + rightBegin,
+									rightEnd - rightBegin, target + begin + pieceBegin);
+							});
+						}
+					}
+					pool.wait();
+
+					using std::swap;
+					swap(source, target);
+				}
+			}
+			catch (...)
+			{
+				finish_jobs(pool);
+				for (std::size_t index = 0; index < length; ++index)
+					buffer[index].~T();
+				throw;
+			}
+
+			for (std::size_t index = 0; index < length; ++index)
+				buffer[index].~T();
+		}
+
+		/// Merges sorted chunks of \a chunkLength values in parallel rounds without a buffer
+		///
+		/// Each round merges neighbouring pairs in place, with one job for each pair.
+		template <Callable<bool, const T&, const T&> C, typename P>
+		void merge_chunks_parallel_inplace (C & comparer, P & pool, std::size_t chunkLength)
+		{
+			assert(chunkLength > 0);
+
+			for (auto width = chunkLength; width < length; width = width * 2)
+			{
+				for (std::size_t begin = 0; begin + width < length; begin += 2 * width)
+				{
+					const auto middle = begin + width;
+					const auto end = width < length - middle ? middle + width : length;
+					pool.submit([this, begin, middle, end, &comparer]()
+					{
+						merge_buffered(comparer, begin, middle, end, nullptr, 0);
+					});
+				}
+				pool.wait();
+			}
+		}
+
+		/// Sorts values from \a begin to \a end by partitioning and sorting both partitions as
+		/// concurrent jobs in \a pool
+		///
+		/// Partitions with at most \a grain values or partitions reached after \a limit recursions
+		/// will be sorted sequentially.
+		template <Callable<bool, const T&, const T&> C, typename P>
+		void intro_sort_parallel (C & comparer, P & pool, std::size_t begin, std::size_t end, std::size_t limit, std::size_t grain)
+		{
+			assert(begin <= end);
+			assert(end <= length);
+
+			while (end - begin > grain and end - begin > 3 and limit > 0)
+			{
+				--limit;
+				const auto cut = partition_randomly(comparer, begin, end);
+				pool.submit([this, cut, end, limit, grain, &comparer, &pool]()
+				{
+					intro_sort_parallel(comparer, pool, cut, end, limit, grain);
+				});
+				end = cut;
+			}
+			array_view(values + begin, end - begin).sort(comparer);
+		}
+
+		/// Returns the amount of values which is worth one job when sorting with \a threadCount
+		/// threads
+		constexpr std::size_t parallel_grain (std::size_t threadCount) const
+		{
+			const auto grain = length / (threadCount * 8);
+			return grain > 4096 ? grain : 4096;
+		}
+
+
 		/// Partitions with pivot taken randomly from the values
 		template <Callable<bool, const T&, const T&> C>
 		constexpr std::size_t partition_randomly (C comparer, std::size_t begin, std::size_t end)
@@ -435,6 +1290,155 @@ namespace stdext
 			}
 		}
 
+		/// Stable partitions from \a begin to the end of the view with an auxiliary \a buffer
+		///
+		/// The values are scanned in chunks, with conform values being moved forward and other
+		/// values being moved into the \a buffer, which provides uninitialised storage for \a
+		/// capacity values. Each chunk ends when the buffer is full, and its negative values are
+		/// moved back behind its positive ones. The negative values of former chunks are rotated
+		/// behind the positive values of each later chunk. A buffer for all values is passed in a
+		/// single pass. The index of the first non-conform value is returned. If \a predictor
+		/// throws, the buffered values are moved back into the view, which then holds all values in
+		/// an unspecified order, and the buffer is left empty.
+		template <Callable<bool, const T&> C>
+		std::size_t partition_stabely_buffered (C & predictor, std::size_t begin, T * buffer, std::size_t capacity)
+		{
+			assert(begin <= length);
+			assert(capacity > 0);
+
+			auto cut = begin;
+			auto next = begin;
+			while (next < length)
+			{
+				const auto chunk = next;
+				auto positive = next;
+				auto buffered = std::size_t(0);
+				try
+				{
+					for (; next < length and buffered < capacity; ++next)
+					{
+						if (predictor(values[next]))
+						{
+							if (positive != next)
+								values[positive] = std::move(values[next]);
+							++positive;
+						}
+						else
+						{
+							new (buffer + buffered) T(std::move(values[next]));
+							++buffered;
+						}
+					}
+				}
+				catch (...)
+				{
+					// the moved-from slots of the chunk are the ones behind its positive values
+					for (std::size_t index = 0; index < buffered; ++index)
+					{
+						values[positive + index] = std::move(buffer[index]);
+						buffer[index].~T();
+					}
+					throw;
+				}
+
+				for (std::size_t index = 0; index < buffered; ++index)
+				{
+					values[positive + index] = std::move(buffer[index]);
+					buffer[index].~T();
+				}
+
+				rotate(cut, positive, chunk);
+				cut += positive - chunk;
+			}
+			return cut;
+		}
+
+		/// Applies the permutation whose index slots are returned by \a permutation
+		///
+		/// The value at each index will be replaced by the value at the index held by its slot.
+		/// Cycles of the permutation are followed with a single temporary value. Visited slots are
+		/// set to their own index.
+		template <Callable<std::size_t&, std::size_t> P>
+		constexpr void permute (P permutation)
+		{
+			for (std::size_t start = 0; start < length; ++start)
+			{
+				if (permutation(start) == start)
+					continue;
+
+				auto temporary = std::move(values[start]);
+				auto current = start;
+				while (permutation(current) != start)
+				{
+					const auto next = permutation(current);
+					values[current] = std::move(values[next]);
+					permutation(current) = current;
+					current = next;
+				}
+				values[current] = std::move(temporary);
+				permutation(current) = current;
+			}
+		}
+
+		/// Sorts by keys which \a extractor computes once per value
+		///
+		/// Pairs of key and index are sorted in a buffer from \a allocator by the keys' less-than
+		/// operator, and the view is permuted accordingly afterwards. Ties are broken by index, if
+		/// sorting \a stabely. If the buffer cannot be allocated, the keys are computed within each
+		/// comparison instead. If \a extractor or sorting throws, the buffer is released before the
+		/// exception is passed on.
+		template <Callable_<const T&> E, Allocator A>
+		void sort_by_cached_key (E & extractor, A & allocator, bool stabely)
+		{
+			using key_type = std::decay_t<decltype(extractor(values[0]))>;
+			struct keyed_index
+			{
+				key_type key;
+				std::size_t index;
+			};
+
+			auto allocation = allocator.template allocate<keyed_index>(length);
+			if (allocation.length() < length)
+			{
+				allocator.deallocate(allocation);
+				sort_stabely([&extractor](const T & a, const T & b){return extractor(a) < extractor(b);}, allocator);
+				return;
+			}
+
+			keyed_index * entries = allocation.data();
+			auto built = std::size_t(0);
+			const auto release = [entries, &built, &allocator, &allocation]()
+			{
+				for (std::size_t index = 0; index < built; ++index)
+					entries[index].~keyed_index();
+				allocator.deallocate(allocation);
+			};
+
+			try
+			{
+				for (; built < length; ++built)
+					new (entries + built) keyed_index{extractor(values[built]), built};
+
+				auto keyed = array_view<keyed_index>(entries, length);
+				const auto comparer = [stabely](const keyed_index & a, const keyed_index & b)
+				{
+					return a.key < b.key or (stabely and a.index < b.index and not (b.key < a.key));
+				};
+				if constexpr (std::is_nothrow_copy_constructible<keyed_index>::value and std::is_nothrow_copy_assignable<keyed_index>::value)
+					keyed.sort(comparer);
+				else
+					keyed.sort_stabely(comparer, allocator);
+
+				permute([entries](std::size_t index) -> std::size_t & {return entries[index].index;});
+			}
+			catch (...)
+			{
+				release();
+				throw;
+			}
+			release();
+		}
+
 
 	public:
 
@@ -471,6 +1475,12 @@ namespace stdext
 			return length;
 		}
 
+		/// Returns the pointer to the first element in the view
+		constexpr T * data () const
+		{
+			return values;
+		}
+
 		/// Swaps the view, not its elements, between \a first and \a second
 		///
 		/// After swapping, \a first will see all the elements which \a second has seen before the
@@ -510,6 +1520,16 @@ namespace stdext
 			return index < length ? hitter(values[index], std::move(attributes) ...) : misser(std::move(attributes) ...);
 		}
 
+		/// Direct access
+		///
+		/// A reference to the value at \a index will be returned. The \a index must be less than
+		/// the length. Together with length and split, the view models an indexed bounded sequence.
+		constexpr T & at (std::size_t index) const
+		{
+			assert(index < length);
+			return values[index];
+		}
+
 
 
 		/// Prefix decomposition
@@ -552,6 +1572,20 @@ namespace stdext
 			return value;
 		}
 
+		/// Chunked folding
+		///
+		/// The values are contiguous, so the whole view is folded over \a value by \a combiner as a
+		/// single chunk, unless it is empty. Sequencers on the view process its values in tight
+		/// loops this way.
+		///
+		template <typename V, Callable<V, V, array_view> C>
+		constexpr V fold_chunks (C combiner, V value) const
+		{
+			if (length == 0)
+				return value;
+			return combiner(std::move(value), *this);
+		}
+
 		/// Complete backward folding
 		///
 		/// All values in the view are consecutively folded over \a value by \a combiner. The
@@ -626,6 +1660,15 @@ namespace stdext
 			return std::make_tuple(pre, post);
 		}
 
+		/// Splitting at \a index
+		///
+		/// The views on the values before and from \a index will be returned. If \a index is beyond
+		/// the view, the second view is empty. See split_prefix with count.
+		constexpr std::tuple<array_view, array_view> split (std::size_t index) const
+		{
+			return split_prefix(index);
+		}
+
 		/// Prefix splitting with prediction
 		///
 		/// The view will be splitted into two partitions. The first partition will be the longest prefix
@@ -1809,7 +2852,8 @@ namespace stdext
 				"Values of array_view must be nothrow copy constructible!");
 			static_assert(std::is_nothrow_copy_assignable<T>::value,
 				"Values of array_view must be nothrow copy assignable!");
-			rotate(0, length, count);
+			if (length > 0)
+				rotate(0, length, length - count % length);
 		}
 
 		/// Revertion
@@ -1887,6 +2931,101 @@ namespace stdext
 		}
 
 
+		/// Stable partition with an auxiliary buffer from \a allocator
+		///
+		/// All values will be rearranged into two contiguous parts which span the whole view like
+		/// with \a partition_stabely, but values which are not conform with the \a predictor are
+		/// moved aside into a buffer from \a allocator, so that the partition is done in one pass.
+		/// A caller provided scratch buffer can be passed as a stack allocator. If the buffer is
+		/// shorter than the amount of non-conform values, the view is partitioned in chunks, and if
+		/// no buffer could be allocated, the partition will be performed in place. If \a predictor
+		/// throws, the view keeps all values in an unspecified order and the buffer is released.
+		///
+		/// @param predictor  A callable object which takes a constant reference to some value and
+		///                   returns a boolean indicating whether the value is conform with the
+		///                   predicate or not.
+		/// @param allocator  Allocator from which the auxiliary buffer is requested
+		///
+		/// @note Time complexity is linear with the length of the view, if the buffer could hold all
+		///       non-conform values.
+		///
+		template <Callable<bool, const T&> C, Allocator A>
+		std::tuple<array_view, array_view> partition_stabely (C predictor, A & allocator)
+		{
+			static_assert(not std::is_const<T>::value, "Value of array_view must not be constant!");
+			static_assert(std::is_nothrow_move_constructible<T>::value,
+				"Value of array_view must be at least nothrow move constructible!");
+			static_assert(std::is_nothrow_move_assignable<T>::value,
+				"Value of array_view must be at least nothrow move assignable!");
+
+			// skip any positive prefix
+			auto begin = std::size_t(0);
+			while (begin < length and predictor(values[begin]))
+				++begin;
+
+			if (begin == length)
+				return std::make_tuple(*this, array_view(values + length, 0));
+
+			auto allocation = allocator.template allocate<T>(length - begin);
+			if (allocation.data() == nullptr or allocation.length() == 0)
+			{
+				allocator.deallocate(allocation);
+				return partition_stabely(std::move(predictor));
+			}
+
+			try
+			{
+				const auto cut = partition_stabely_buffered(predictor, begin, allocation.data(), allocation.length());
+				allocator.deallocate(allocation);
+				return std::make_tuple(array_view(values, cut), array_view(values + cut, length - cut));
+			}
+			catch (...)
+			{
+				allocator.deallocate(allocation);
+				throw;
+			}
+		}
+
+
+		/// Adjacent duplicate removal
+		///
+		/// All values will be rearranged into two contiguous parts which span the whole view. The
+		/// first part will contain each value which does not match its kept predecessor with \a
+		/// matcher, in the original order. The second part will contain the remaining values in a
+		/// valid but unspecified state. If the view is sorted, the first part contains each value
+		/// once. Values are compacted in one pass.
+		///
+		/// @param matcher  A callable object which takes two constant references of type \a T and
+		///                 returns a boolean indicating whether both values are duplicates
+		///
+		/// @note Time complexity is linear in the length of the view.
+		///
+		template <Callable<bool, const T&, const T&> M>
+		constexpr std::tuple<array_view, array_view> unique (M matcher)
+		{
+			static_assert(not std::is_const<T>::value, "Value of array_view must not be constant!");
+
+			if (length == 0)
+				return std::make_tuple(*this, array_view());
+
+			// skip the prefix without any duplicate, which needs no moving
+			auto next = std::size_t(1);
+			while (next < length and not matcher(values[next-1], values[next]))
+				++next;
+
+			auto kept = next;
+			for (; next < length; ++next)
+			{
+				if (not matcher(values[kept-1], values[next]))
+				{
+					values[kept] = std::move(values[next]);
+					++kept;
+				}
+			}
+			return std::make_tuple(array_view(values, kept), array_view(values + kept, length - kept));
+		}
+
+
 		/// Unstable partition
 		///
 		/// All values will be rearranged into two contiguous parts which span the whole view. The
@@ -2060,7 +3199,10 @@ namespace stdext
 				return std::make_tuple(array_view(), *this);
 
 			min_heap_select(comparer, 0, count, length);
-			pop_total_heap([&](const auto & a, const auto & b){return comparer(b, a);}, 0, count);
+			if (is_sorting_network_applicable_v<T, C> and count <= maxSortingNetworkLength)
+				small_sort(comparer, 0, count);
+			else
+				pop_total_heap([&](const auto & a, const auto & b){return comparer(b, a);}, 0, count);
 			const auto pre = array_view(values, count);
 			const auto post = array_view(values + count, length - count);
 			return std::make_tuple(pre, post);
@@ -2124,6 +3266,37 @@ namespace stdext
 			});
 		}
 
+		/// Multiple nth element sorting
+		///
+		/// Values will be rearranged such that the value at each index in \a indices corresponds to
+		/// the value if sorted with \a comparer. The order defined by \a comparer must be strict
+		/// weak. The \a indices must be in ascending order. Only partitions which contain some of
+		/// the \a indices will be partitioned further. A bounded sequence will be returned which
+		/// holds a reference for each index in \a indices, or an empty optional container, if the
+		/// index is equal or greater the view's length.
+		///
+		/// @param comparer  A callable object which takes two constant references of type \a T and
+		///                  returns a boolean indicating if both values are in right order
+		/// @param indices   Ascending indices whose values are selected
+		///
+		/// @note Average time complexity is n*log(k) with n being the length of the view and k being
+		///       the amount of indices.
+		///
+		template <Callable<bool, const T&, const T&> C>
+		constexpr auto sort_nth_many (C comparer, array_view<const std::size_t> indices)
+		{
+			static_assert(not std::is_const<T>::value, "Value of array_view must be not const!");
+
+			const auto ranks = std::get<0>(indices.lower_bound([](auto a, auto b){return a < b;}, length));
+			if (not ranks.empty())
+				intro_select_many(comparer, 0, length, ranks.data(), ranks.length(), lg2(length) * 2);
+
+			return bounded_transformer(indices, [values = values, length = length](std::size_t index)
+			{
+				return index < length ? optional<T&>(values + index) : optional<T&>();
+			});
+		}
+
 		/// Unstable sorting
 		///
 		/// Values will be sorted according to order defined by \a comparer. The order must be strict
@@ -2147,34 +3320,468 @@ namespace stdext
 			if (length > 1)
 			{
 				const auto recursionLimit = lg2(length) * 2;
-				const auto minPartitionLength = 16;
+				const auto minPartitionLength = is_sorting_network_applicable_v<T, C> ? maxSortingNetworkLength : 16;
 				intro_sort(comparer, 0, length, recursionLimit, minPartitionLength);
-				for (std::size_t begin = 0; begin < length; begin += minPartitionLength);
-				{
-					const auto hypEnd = begin + minPartitionLength;
-					const auto end = hypEnd <= length ? hypEnd : length;
-					insertion_sort(comparer, begin, end);
-				}
+			}
+		}
+
+		/// Stable sorting with an auxiliary buffer from \a allocator
+		///
+		/// Values will be sorted according to order defined by \a comparer. The order must be strict
+		/// weak. Equivalent values keep their previous order. Natural runs in the view are detected
+		/// and merged with galloping. A buffer for half the length of the view is requested from \a
+		/// allocator. If the allocation fails or turns out too small, merges which do not fit will
+		/// be performed in place.
+		///
+		/// @param comparer   A callable object which takes two constant references of type \a T and
+		///                   returns a boolean indicating if both values are in right order
+		/// @param allocator  Allocator from which the auxiliary buffer is requested
+		///
+		/// @note Time complexity is n*log(n) with n being the length of the view, if the buffer could
+		///       be allocated, and linear for already sorted views.
+		///
+		template <Callable<bool, const T&, const T&> C, Allocator A>
+		void sort_stabely (C comparer, A & allocator)
+		{
+			static_assert(not std::is_const<T>::value, "Value of array_view must be not constant!");
+			static_assert(std::is_nothrow_move_constructible<T>::value,
+				"Value of array_view must be at least nothrow move constructible!");
+			static_assert(std::is_nothrow_move_assignable<T>::value,
+				"Value of array_view must be at least nothrow move assignable!");
+
+			if (length > 1)
+			{
+				auto allocation = allocator.template allocate<T>(length / 2);
+				merge_sort_buffered(comparer, allocation.data(), allocation.data() != nullptr ? allocation.length() : 0);
+				allocator.deallocate(allocation);
 			}
 		}
 
 		/// Stable sorting
+		///
+		/// Values will be sorted like with \a sort_stabely with an allocator, but the auxiliary
+		/// buffer is requested from the \a system_allocator.
+		///
 		template <Callable<bool, const T&, const T&> C>
-		constexpr void sort_stabely (C comparer)
+		void sort_stabely (C comparer)
+		{
+			auto allocator = system_allocator();
+			sort_stabely(std::move(comparer), allocator);
+		}
+
+		/// Unstable sorting by cached keys with a buffer from \a allocator
+		///
+		/// Values will be sorted by the less-than order of the keys computed by \a extractor. Each
+		/// key is computed only once, which pays off if computing keys is expensive, e.g. when they
+		/// have to be decoded. A buffer of key and index pairs is requested from \a allocator and
+		/// sorted, and the values are permuted accordingly afterwards. If the buffer cannot be
+		/// allocated, keys will be computed within each comparison.
+		///
+		/// @param extractor  A callable object which takes a constant reference of type \a T and
+		///                   returns its key
+		/// @param allocator  Allocator from which the buffer is requested
+		///
+		/// @note Average time complexity is n*log(n) with n being the length of the view, while
+		///       only n keys are computed.
+		///
+		template <Callable_<const T&> E, Allocator A>
+		void sort_by_key (E extractor, A & allocator)
 		{
 			static_assert(not std::is_const<T>::value, "Value of array_view must be not constant!");
-			static_assert(std::is_nothrow_copy_constructible<T>::value,
-				"Value of array_view must be at least nothrow copy constructible!");
-			static_assert(std::is_nothrow_copy_assignable<T>::value,
-				"Value of array_view must be at least nothrow copy assignable!");
+			static_assert(std::is_nothrow_move_constructible<T>::value,
+				"Value of array_view must be at least nothrow move constructible!");
+			static_assert(std::is_nothrow_move_assignable<T>::value,
+				"Value of array_view must be at least nothrow move assignable!");
 
 			if (length > 1)
-				merge_sort(comparer, 0, length, 16);
+				sort_by_cached_key(extractor, allocator, false);
+		}
+
+		/// Unstable sorting by cached keys
+		///
+		/// The buffer is requested from the system allocator. See sort_by_key with allocator.
+		template <Callable_<const T&> E>
+		void sort_by_key (E extractor)
+		{
+			auto allocator = system_allocator();
+			sort_by_key(std::move(extractor), allocator);
+		}
+
+		/// Stable sorting by cached keys with a buffer from \a allocator
+		///
+		/// Values will be sorted by the less-than order of the keys computed by \a extractor.
+		/// Values with equivalent keys keep their previous order. Each key is computed only once.
+		/// See sort_by_key with allocator.
+		///
+		/// @param extractor  A callable object which takes a constant reference of type \a T and
+		///                   returns its key
+		/// @param allocator  Allocator from which the buffer is requested
+		///
+		template <Callable_<const T&> E, Allocator A>
+		void sort_stabely_by_key (E extractor, A & allocator)
+		{
+			static_assert(not std::is_const<T>::value, "Value of array_view must be not constant!");
+			static_assert(std::is_nothrow_move_constructible<T>::value,
+				"Value of array_view must be at least nothrow move constructible!");
+			static_assert(std::is_nothrow_move_assignable<T>::value,
+				"Value of array_view must be at least nothrow move assignable!");
+
+			if (length > 1)
+				sort_by_cached_key(extractor, allocator, true);
+		}
+
+		/// Stable sorting by cached keys
+		///
+		/// The buffer is requested from the system allocator. See sort_stabely_by_key with
+		/// allocator.
+		template <Callable_<const T&> E>
+		void sort_stabely_by_key (E extractor)
+		{
+			auto allocator = system_allocator();
+			sort_stabely_by_key(std::move(extractor), allocator);
+		}
+
+		/// Parallel unstable sorting with an auxiliary buffer from \a allocator
+		///
+		/// Values will be sorted according to order defined by \a comparer on \a threadCount
+		/// threads. The view is split into one chunk per thread and the chunks are sorted
+		/// concurrently. The sorted chunks are merged in rounds through a buffer for all values,
+		/// which is requested from \a allocator. Each merge is split into pieces which are merged
+		/// concurrently. If the buffer cannot be allocated, the view will be sorted by partitioning
+		/// with both partitions being sorted concurrently. The \a comparer will be called
+		/// concurrently. If it throws, all jobs are finished, the buffer is released and the first
+		/// exception is passed on, leaving the values in unspecified order.
+		///
+		/// @param comparer     A callable object which takes two constant references of type \a T
+		///                     and returns a boolean indicating if both values are in right order
+		/// @param allocator    Allocator from which the auxiliary buffer is requested
+		/// @param threadCount  Amount of threads including the calling one
+		///
+		/// @note Time complexity is n*log(n)/p + n with n being the length of the view and p being
+		///       the amount of threads.
+		///
+		/// @note The header thread_pool.hpp has to be included for parallel sorting.
+		///
+		template <Callable<bool, const T&, const T&> C, Allocator A, typename P = thread_pool>
+		void sort_parallel (C comparer, A & allocator, std::size_t threadCount)
+		{
+			static_assert(not std::is_const<T>::value, "Value of array_view must be not const!");
+			static_assert(std::is_nothrow_move_constructible<T>::value,
+				"Value of array_view must be at least nothrow move constructible!");
+			static_assert(std::is_nothrow_move_assignable<T>::value,
+				"Value of array_view must be at least nothrow move assignable!");
+
+			if (threadCount < 2 or length < 2)
+			{
+				sort(std::move(comparer));
+				return;
+			}
+
+			auto pool = P(threadCount);
+			const auto grain = parallel_grain(threadCount);
+			auto allocation = allocator.template allocate<T>(length);
+			try
+			{
+				if (allocation.data() != nullptr and allocation.length() >= length)
+				{
+					const auto chunkLength = (length + threadCount - 1) / threadCount;
+					for (std::size_t begin = 0; begin < length; begin += chunkLength)
+					{
+						const auto count = chunkLength < length - begin ? chunkLength : length - begin;
+						pool.submit([this, begin, count, &comparer]()
+						{
+							array_view(values + begin, count).sort(comparer);
+						});
+					}
+					pool.wait();
+					merge_chunks_parallel(comparer, pool, allocation.data(), chunkLength, grain);
+				}
+				else
+				{
+					intro_sort_parallel(comparer, pool, 0, length, lg2(length) * 2, grain);
+					pool.wait();
+				}
+			}
+			catch (...)
+			{
+				finish_jobs(pool);
+				allocator.deallocate(allocation);
+				throw;
+			}
+			allocator.deallocate(allocation);
+		}
+
+		/// Parallel unstable sorting
+		///
+		/// Values will be sorted like with \a sort_parallel with an allocator, but the auxiliary
+		/// buffer is requested from the \a system_allocator.
+		///
+		template <Callable<bool, const T&, const T&> C>
+		void sort_parallel (C comparer, std::size_t threadCount)
+		{
+			auto allocator = system_allocator();
+			sort_parallel(std::move(comparer), allocator, threadCount);
+		}
+
+		/// Parallel stable sorting with an auxiliary buffer from \a allocator
+		///
+		/// Values will be sorted according to order defined by \a comparer on \a threadCount
+		/// threads. Equivalent values keep their previous order. The view is split into one chunk
+		/// per thread and the chunks are stable sorted concurrently. The sorted chunks are merged
+		/// in rounds through a buffer for all values, which is requested from \a allocator. Each
+		/// merge is split into pieces which are merged concurrently. If the buffer cannot be
+		/// allocated, chunks will be merged in place with one thread per merge. The \a comparer
+		/// will be called concurrently. If it throws, all jobs are finished, the buffer is released
+		/// and the first exception is passed on, leaving the values in unspecified order.
+		///
+		/// @param comparer     A callable object which takes two constant references of type \a T
+		///                     and returns a boolean indicating if both values are in right order
+		/// @param allocator    Allocator from which the auxiliary buffer is requested
+		/// @param threadCount  Amount of threads including the calling one
+		///
+		/// @note Time complexity is n*log(n)/p + n*log(p)/p with n being the length of the view and p
+		///       being the amount of threads, if the buffer could be allocated.
+		///
+		/// @note The header thread_pool.hpp has to be included for parallel sorting.
+		///
+		template <Callable<bool, const T&, const T&> C, Allocator A, typename P = thread_pool>
+		void sort_stabely_parallel (C comparer, A & allocator, std::size_t threadCount)
+		{
+			static_assert(not std::is_const<T>::value, "Value of array_view must be not constant!");
+			static_assert(std::is_nothrow_move_constructible<T>::value,
+				"Value of array_view must be at least nothrow move constructible!");
+			static_assert(std::is_nothrow_move_assignable<T>::value,
+				"Value of array_view must be at least nothrow move assignable!");
+
+			if (threadCount < 2 or length < 2)
+			{
+				sort_stabely(std::move(comparer), allocator);
+				return;
+			}
+
+			auto pool = P(threadCount);
+			auto allocation = allocator.template allocate<T>(length);
+			const auto hasBuffer = allocation.data() != nullptr and allocation.length() >= length;
+			const auto buffer = hasBuffer ? allocation.data() : nullptr;
+
+			try
+			{
+				const auto chunkLength = (length + threadCount - 1) / threadCount;
+				for (std::size_t begin = 0; begin < length; begin += chunkLength)
+				{
+					const auto count = chunkLength < length - begin ? chunkLength : length - begin;
+					pool.submit([this, begin, count, buffer, &comparer]()
+					{
+						auto chunk = array_view(values + begin, count);
+						if (count > 1)
+							chunk.merge_sort_buffered(comparer, buffer != nullptr ? buffer + begin : nullptr, buffer != nullptr ? count : 0);
+					});
+				}
+				pool.wait();
+
+				if (hasBuffer)
+					merge_chunks_parallel(comparer, pool, buffer, chunkLength, parallel_grain(threadCount));
+				else
+					merge_chunks_parallel_inplace(comparer, pool, chunkLength);
+			}
+			catch (...)
+			{
+				finish_jobs(pool);
+				allocator.deallocate(allocation);
+				throw;
+			}
+			allocator.deallocate(allocation);
+		}
+
+		/// Parallel stable sorting
+		///
+		/// Values will be sorted like with \a sort_stabely_parallel with an allocator, but the
+		/// auxiliary buffer is requested from the \a system_allocator.
+		///
+		template <Callable<bool, const T&, const T&> C>
+		void sort_stabely_parallel (C comparer, std::size_t threadCount)
+		{
+			auto allocator = system_allocator();
+			sort_stabely_parallel(std::move(comparer), allocator, threadCount);
+		}
+
+
+
+
+		/// Lower bound splitting
+		///
+		/// The view will be splitted into two partitions. The first partition will contain all
+		/// values which are less than \a value and the second partition will contain all values
+		/// which are not less than \a value. The values must be sorted by \a comparer.
+		///
+		/// @param comparer  A callable object which takes two constant references of type \a T and
+		///                  returns a boolean indicating if both values are in right order
+		/// @param value     Value which is searched for
+		///
+		/// @note Time complexity is logarithmic in the length of the view.
+		///
+		template <Callable<bool, const T&, const T&> C>
+		constexpr std::tuple<array_view, array_view> lower_bound (C comparer, const T & value) const
+		{
+			const auto bound = lower_bound_index(comparer, value);
+			return std::make_tuple(array_view(values, bound), array_view(values + bound, length - bound));
+		}
+
+		/// Upper bound splitting
+		///
+		/// The view will be splitted into two partitions. The first partition will contain all
+		/// values which are not greater than \a value and the second partition will contain all
+		/// values which are greater than \a value. The values must be sorted by \a comparer.
+		///
+		/// @param comparer  A callable object which takes two constant references of type \a T and
+		///                  returns a boolean indicating if both values are in right order
+		/// @param value     Value which is searched for
+		///
+		/// @note Time complexity is logarithmic in the length of the view.
+		///
+		template <Callable<bool, const T&, const T&> C>
+		constexpr std::tuple<array_view, array_view> upper_bound (C comparer, const T & value) const
+		{
+			const auto bound = upper_bound_index(comparer, value);
+			return std::make_tuple(array_view(values, bound), array_view(values + bound, length - bound));
+		}
+
+		/// Equivalent range splitting
+		///
+		/// The view will be splitted into three partitions. The first partition will contain all
+		/// values which are less than \a value, the second partition will contain all values which
+		/// are equivalent to \a value and the third partition will contain all values which are
+		/// greater than \a value. The values must be sorted by \a comparer.
+		///
+		/// @param comparer  A callable object which takes two constant references of type \a T and
+		///                  returns a boolean indicating if both values are in right order
+		/// @param value     Value which is searched for
+		///
+		/// @note Time complexity is logarithmic in the length of the view.
+		///
+		template <Callable<bool, const T&, const T&> C>
+		constexpr std::tuple<array_view, array_view, array_view> equal_range (C comparer, const T & value) const
+		{
+			const auto lower = lower_bound_index(comparer, value);
+			const auto upper = lower + array_view(values + lower, length - lower).upper_bound_index(comparer, value);
+			const auto pre = array_view(values, lower);
+			const auto middle = array_view(values + lower, upper - lower);
+			const auto post = array_view(values + upper, length - upper);
+			return std::make_tuple(pre, middle, post);
+		}
+
+		/// Sorted containment test
+		///
+		/// The view will be tested on containing some value which is equivalent to \a value. The
+		/// values must be sorted by \a comparer.
+		///
+		/// @param comparer  A callable object which takes two constant references of type \a T and
+		///                  returns a boolean indicating if both values are in right order
+		/// @param value     Value which is searched for
+		///
+		/// @note Time complexity is logarithmic in the length of the view.
+		///
+		template <Callable<bool, const T&, const T&> C>
+		constexpr bool contains_sorted (C comparer, const T & value) const
+		{
+			const auto bound = lower_bound_index(comparer, value);
+			return bound < length and not comparer(value, values[bound]);
+		}
+
+		/// Index sorting
+		///
+		/// The \a indices will be set to the indices of the values in the order defined by \a
+		/// comparer, such that the value at the first index is the lowest one. The values themselves
+		/// are not moved. Equivalent values are ordered by their index, so the order is the one of
+		/// stable sorting. The length of \a indices must equal the length of the view.
+		///
+		/// @param comparer  A callable object which takes two constant references of type \a T and
+		///                  returns a boolean indicating if both values are in right order
+		/// @param indices   View to which the sorted indices are written
+		///
+		/// @note Average time complexity is n*log(n) with n being the length of the view.
+		///
+		template <Callable<bool, const T&, const T&> C>
+		constexpr void sort_indices (C comparer, array_view<std::size_t> indices) const
+		{
+			assert(indices.length() == length);
+
+			std::size_t * permutation = indices.data();
+			for (std::size_t index = 0; index < length; ++index)
+				permutation[index] = index;
+
+			indices.sort([values = values, &comparer](std::size_t a, std::size_t b)
+			{
+				return comparer(values[a], values[b]) or (a < b and not comparer(values[b], values[a]));
+			});
+		}
+
+		/// Permutation application
+		///
+		/// Values will be rearranged such that the value at each index is the value which has been
+		/// at the index given by \a indices, as written by sort_indices. The permutation is applied
+		/// in place by following its cycles, which moves each value once and needs only a single
+		/// temporary value. The \a indices are used for marking visited values and will be the
+		/// identity afterwards. The length of \a indices must equal the length of the view.
+		///
+		/// @param indices  Permutation of the indices of the view
+		///
+		/// @note Time complexity is linear in the length of the view.
+		///
+		constexpr void apply_permutation (array_view<std::size_t> indices)
+		{
+			static_assert(not std::is_const<T>::value, "Value of array_view must be not const!");
+			assert(indices.length() == length);
+
+			std::size_t * permutation = indices.data();
+			permute([permutation](std::size_t index) -> std::size_t & {return permutation[index];});
 		}
 
 	};
 
 
+	/// Permutation application on several views
+	///
+	/// The permutation given by \a indices will be applied to all \a views in a single traversal
+	/// of its cycles, as if apply_permutation was called on each of them. This keeps parallel
+	/// arrays consistent which are sorted by the key in one of them. The \a indices will be the
+	/// identity afterwards. The length of each view must equal the length of \a indices.
+	///
+	/// @param indices  Permutation of the indices of the views
+	/// @param views    Views whose values are rearranged
+	///
+	/// @note Time complexity is linear in the length of the views.
+	///
+	template <typename ... Ts>
+	constexpr void apply_permutation (array_view<std::size_t> indices, array_view<Ts> ... views)
+	{
+		static_assert((not std::is_const<Ts>::value and ...), "Values of array_view must be not const!");
+		assert(((views.length() == indices.length()) and ...));
+
+		std::size_t * permutation = indices.data();
+		for (std::size_t start = 0; start < indices.length(); ++start)
+		{
+			if (permutation[start] == start)
+				continue;
+
+			auto temporaries = std::make_tuple(std::move(views.data()[start]) ...);
+			auto current = start;
+			while (permutation[current] != start)
+			{
+				const auto next = permutation[current];
+				((views.data()[current] = std::move(views.data()[next])), ...);
+				permutation[current] = current;
+				current = next;
+			}
+			[&]<std::size_t ... I>(std::index_sequence<I ...>)
+			{
+				((views.data()[current] = std::move(std::get<I>(temporaries))), ...);
+			}(std::index_sequence_for<Ts ...>());
+			permutation[current] = current;
+		}
+	}
+
+
 
 }
 
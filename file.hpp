@@ -0,0 +1,384 @@
+/// @file file.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_FILE_HPP__
+#define __STDEXT_FILE_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/array_view.hpp>
+#include <stdext/optional.hpp>
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace stdext
+{
+
+	/// Exception for failed file operations
+	///
+	/// Besides a reason, the exception holds the error code of the operating system.
+	class file_error
+	{
+
+		private:
+
+			const char * reason;
+			int code;
+
+		public:
+
+			constexpr file_error (const char * reason, int code) noexcept
+				: reason(reason), code(code)
+			{}
+
+			constexpr const char * what () const
+			{
+				return reason;
+			}
+
+			constexpr int error_code () const
+			{
+				return code;
+			}
+	};
+
+
+	/// Expected pattern of accesses to file contents
+	enum class access_pattern
+	{
+		normal,
+		sequential,
+		random
+	};
+
+
+	/// Read-only memory mapping of a whole file
+	///
+	/// The contents of the file are exposed as a view on constant bytes without copying them. Pages
+	/// are read by the operating system when they are touched first, so the expected access
+	/// pattern is passed on as a hint: sequential access enables aggressive read-ahead, random
+	/// access disables it. The mapping stays valid until the object is destructed, even if the
+	/// file is closed.
+	class mapped_file
+	{
+
+		private:
+
+			const unsigned char * bytes = nullptr;
+			std::size_t count = 0;
+
+		public:
+
+			/// Maps the file at \a path with access \a pattern
+			///
+			/// If the file cannot be opened or mapped, the exception \a file_error will be thrown.
+			explicit mapped_file (const char * path, access_pattern pattern = access_pattern::sequential)
+			{
+				const auto descriptor = ::open(path, O_RDONLY | O_CLOEXEC);
+				if (descriptor < 0)
+					throw file_error("file cannot be opened", errno);
+
+				struct stat status;
+				if (::fstat(descriptor, &status) != 0)
+				{
+					const auto code = errno;
+					::close(descriptor);
+					throw file_error("file cannot be inspected", code);
+				}
+
+				count = static_cast<std::size_t>(status.st_size);
+				if (count > 0)
+				{
+					auto * mapping = ::mmap(nullptr, count, PROT_READ, MAP_PRIVATE, descriptor, 0);
+					if (mapping == MAP_FAILED)
+					{
+						const auto code = errno;
+						::close(descriptor);
+						throw file_error("file cannot be mapped", code);
+					}
+					bytes = static_cast<const unsigned char *>(mapping);
+				}
+				::close(descriptor);
+				advise(pattern);
+			}
+
+			mapped_file (const mapped_file &) = delete;
+			mapped_file& operator = (const mapped_file &) = delete;
+
+			/// Move constructor
+			///
+			/// The mapping is taken over from \a other, which will be empty afterwards.
+			mapped_file (mapped_file && other) noexcept
+				: bytes(other.bytes), count(other.count)
+			{
+				other.bytes = nullptr;
+				other.count = 0;
+			}
+
+			/// Move assignment
+			///
+			/// The own mapping is swapped with the one of \a other.
+			mapped_file& operator = (mapped_file && other) noexcept
+			{
+				std::swap(bytes, other.bytes);
+				std::swap(count, other.count);
+				return *this;
+			}
+
+			/// Destructor
+			///
+			/// The mapping will be removed, so all views on it become invalid.
+			~mapped_file ()
+			{
+				if (bytes != nullptr)
+					::munmap(const_cast<unsigned char *>(bytes), count);
+			}
+
+			/// Returns a view on all bytes of the file
+			array_view<const unsigned char> view () const
+			{
+				return array_view<const unsigned char>(bytes, count);
+			}
+
+			/// Returns the amount of bytes of the file
+			std::size_t length () const
+			{
+				return count;
+			}
+
+			/// Returns whether the file is empty
+			bool empty () const
+			{
+				return count == 0;
+			}
+
+			/// Passes the expected access \a pattern for the whole mapping on to the operating system
+			///
+			/// The hint does not change the contents, so failures are ignored.
+			void advise (access_pattern pattern) const
+			{
+				if (bytes == nullptr)
+					return;
+
+				const auto advice = pattern == access_pattern::sequential ? MADV_SEQUENTIAL :
+				                    pattern == access_pattern::random ? MADV_RANDOM : MADV_NORMAL;
+				::madvise(const_cast<unsigned char *>(bytes), count, advice);
+			}
+	};
+
+
+	/// Default amount of bytes read at once by file byte sequences
+	constexpr std::size_t fileBufferLength = 1 << 20;
+
+
+	/// Bounded sequence of the bytes read from a file descriptor
+	///
+	/// The bytes are read with large read calls into a buffer, so the sequence works for pipes
+	/// and sockets as well, which cannot be mapped. All copies of the sequence share the buffer
+	/// and the descriptor. Reading is single-pass: once the buffer has been refilled, copies
+	/// positioned before it cannot be used anymore. Folding traverses each buffer in a tight
+	/// loop, and chunked folding hands out each buffer as a view. If reading fails or a copy
+	/// positioned before the buffer is used, the exception \a file_error will be thrown.
+	class file_byte_sequence
+	{
+
+		private:
+
+			struct stream
+			{
+				int descriptor = -1;
+				bool owning = false;
+				std::unique_ptr<unsigned char[]> buffer;
+				std::size_t capacity = 0;
+				std::size_t begin = 0;
+				std::size_t filled = 0;
+				bool ended = false;
+
+				stream (int descriptor, bool owning, std::size_t capacity)
+					: descriptor(descriptor), owning(owning), buffer(new unsigned char[capacity]), capacity(capacity)
+				{}
+
+				stream (const stream &) = delete;
+				stream& operator = (const stream &) = delete;
+
+				~stream ()
+				{
+					if (owning)
+						::close(descriptor);
+				}
+
+				/// Replaces the buffered bytes with the next bytes read from the descriptor
+				void refill ()
+				{
+					begin += filled;
+					filled = 0;
+					while (true)
+					{
+						const auto result = ::read(descriptor, buffer.get(), capacity);
+						if (result > 0)
+						{
+							filled = static_cast<std::size_t>(result);
+							return;
+						}
+						else if (result == 0)
+						{
+							ended = true;
+							return;
+						}
+						else if (errno != EINTR)
+						{
+							ended = true;
+							throw file_error("file cannot be read", errno);
+						}
+					}
+				}
+
+				/// Reads until the byte at \a offset is buffered and returns whether it exists
+				bool reach (std::size_t offset)
+				{
+					if (offset < begin)
+						throw file_error("bytes are not buffered anymore", ESPIPE);
+					while (offset >= begin + filled and not ended)
+						refill();
+					return offset < begin + filled;
+				}
+			};
+
+			std::shared_ptr<stream> source;
+			std::size_t position = 0;
+			std::size_t end = std::size_t(-1);
+
+			file_byte_sequence (std::shared_ptr<stream> source, std::size_t position, std::size_t end)
+				: source(std::move(source)), position(position), end(end)
+			{}
+
+			/// Reads until the byte at \a offset is buffered and returns whether it exists before
+			/// the end
+			bool reach (std::size_t offset) const
+			{
+				return offset < end and source->reach(offset);
+			}
+
+			/// Returns the end of the buffered bytes, limited by the end of the sequence
+			std::size_t buffered_end () const
+			{
+				const auto filled = source->begin + source->filled;
+				return filled < end ? filled : end;
+			}
+
+		public:
+
+			using value_type = unsigned char;
+
+			/// Construction from an open \a descriptor with \a bufferLength
+			///
+			/// The descriptor will not be closed by the sequence.
+			explicit file_byte_sequence (int descriptor, std::size_t bufferLength = fileBufferLength)
+				: source(std::make_shared<stream>(descriptor, false, bufferLength > 0 ? bufferLength : 1))
+			{}
+
+			/// Construction from the file at \a path with \a bufferLength
+			///
+			/// The file is opened for reading and closed when the last copy of the sequence is
+			/// destructed. If the file cannot be opened, the exception \a file_error will be thrown.
+			explicit file_byte_sequence (const char * path, std::size_t bufferLength = fileBufferLength)
+			{
+				const auto descriptor = ::open(path, O_RDONLY | O_CLOEXEC);
+				if (descriptor < 0)
+					throw file_error("file cannot be opened", errno);
+#if defined(POSIX_FADV_SEQUENTIAL)
+				::posix_fadvise(descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+				try
+				{
+					source = std::make_shared<stream>(descriptor, true, bufferLength > 0 ? bufferLength : 1);
+				}
+				catch (...)
+				{
+					::close(descriptor);
+					throw;
+				}
+			}
+
+			bool empty () const
+			{
+				return not reach(position);
+			}
+
+			optional<std::tuple<unsigned char, file_byte_sequence>> decompose () const
+			{
+				using U = optional<std::tuple<unsigned char, file_byte_sequence>>;
+				if (not reach(position))
+					return U();
+				const auto byte = source->buffer[position - source->begin];
+				return U(std::make_tuple(byte, file_byte_sequence(source, position + 1, end)));
+			}
+
+			/// Complete folding
+			///
+			/// All remaining bytes are consecutively folded over \a value by \a combiner. Each
+			/// buffer is traversed in a tight loop.
+			template <typename V, Callable<V, V, unsigned char> C>
+			V fold (C combiner, V value) const
+			{
+				auto offset = position;
+				while (reach(offset))
+				{
+					const unsigned char * bytes = source->buffer.get();
+					const auto skipped = source->begin;
+					const auto last = buffered_end();
+					for (; offset < last; ++offset)
+						value = combiner(std::move(value), bytes[offset - skipped]);
+				}
+				return value;
+			}
+
+			/// Partial folding
+			///
+			/// The remaining bytes are consecutively folded over \a value by \a combiner until it
+			/// returns a false flag. The folded value will be returned along with the sequences of the
+			/// passed bytes and of the bytes which have not been passed. The passed bytes can only be
+			/// traversed again as long as they are buffered, otherwise \a file_error will be thrown.
+			template <typename V, Callable<std::tuple<V, bool>, V, unsigned char> C>
+			std::tuple<V, file_byte_sequence, file_byte_sequence> fold (C combiner, V value) const
+			{
+				auto offset = position;
+				auto keepOn = true;
+				while (keepOn and reach(offset))
+				{
+					std::tie(value, keepOn) = combiner(std::move(value), source->buffer[offset - source->begin]);
+					if (keepOn) ++offset;
+				}
+				return std::make_tuple(std::move(value), file_byte_sequence(source, position, offset), file_byte_sequence(source, offset, end));
+			}
+
+			/// Chunked folding
+			///
+			/// Each buffer of remaining bytes is folded over \a value by \a combiner as a view. See
+			/// the concept ChunkedSequence.
+			template <typename V, Callable<V, V, array_view<const unsigned char>> C>
+			V fold_chunks (C combiner, V value) const
+			{
+				auto offset = position;
+				while (reach(offset))
+				{
+					const auto skipped = offset - source->begin;
+					const auto last = buffered_end();
+					value = combiner(std::move(value), array_view<const unsigned char>(source->buffer.get() + skipped, last - offset));
+					offset = last;
+				}
+				return value;
+			}
+	};
+
+}
+
+#endif
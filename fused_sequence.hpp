@@ -0,0 +1,324 @@
+/// @file fused_sequence.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_FUSED_SEQUENCE_HPP__
+#define __STDEXT_FUSED_SEQUENCE_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/optional.hpp>
+#include <stdext/sequence.hpp>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace stdext
+{
+
+	/// Stage of a fused sequence which passes on elements conforming with \a predictor
+	template <typename P>
+	struct filter_stage
+	{
+		P predictor;
+
+		template <typename E> using result_type = E;
+
+		template <typename E, typename N>
+		constexpr bool feed (E && element, N & next)
+		{
+			return predictor(element) ? next(std::forward<E>(element)) : true;
+		}
+
+		constexpr void unfeed () noexcept
+		{}
+	};
+
+	/// Stage of a fused sequence which passes on elements transformed by \a transformer
+	template <typename T>
+	struct transform_stage
+	{
+		T transformer;
+
+		template <typename E> using result_type = std::decay_t<std::invoke_result_t<const T&, E>>;
+
+		template <typename E, typename N>
+		constexpr bool feed (E && element, N & next)
+		{
+			return next(transformer(std::forward<E>(element)));
+		}
+
+		constexpr void unfeed () noexcept
+		{}
+	};
+
+	/// Stage of a fused sequence which passes on the first \a count elements
+	///
+	/// The stage stops the whole fused sequence as soon as its last element has been passed on.
+	struct take_stage
+	{
+		std::size_t count;
+
+		template <typename E> using result_type = E;
+
+		template <typename E, typename N>
+		constexpr bool feed (E && element, N & next)
+		{
+			if (count == 0)
+				return false;
+			--count;
+			return next(std::forward<E>(element)) and count > 0;
+		}
+
+		/// Reverts the passing of the last passed element
+		constexpr void unfeed () noexcept
+		{
+			++count;
+		}
+	};
+
+	/// Stage of a fused sequence which ignores the first \a count elements
+	struct drop_stage
+	{
+		std::size_t count;
+
+		template <typename E> using result_type = E;
+
+		template <typename E, typename N>
+		constexpr bool feed (E && element, N & next)
+		{
+			if (count == 0)
+				return next(std::forward<E>(element));
+			--count;
+			return true;
+		}
+
+		constexpr void unfeed () noexcept
+		{}
+	};
+
+
+	template <typename E, typename ... Stages> struct fused_result;
+
+	template <typename E> struct fused_result<E>
+	{
+		using type = std::decay_t<E>;
+	};
+
+	template <typename E, typename Stage, typename ... Stages> struct fused_result<E, Stage, Stages ...>
+		: fused_result<typename Stage::template result_type<E>, Stages ...> {};
+
+
+	/// Fused sequence of stages over an indexed bounded sequence
+	///
+	/// Instead of nesting sequencers, each of which copies and rewraps the sequence it holds, a
+	/// fused sequence holds its source, the index of the next source element and a flat tuple of
+	/// stages. Each element of the source is pushed through all stages in a single loop whose
+	/// stage calls are resolved at compile time, so the compiler inlines the whole chain as if it
+	/// was written by hand. The stages hold their counters themselves, so advancing the sequence
+	/// in place with next only changes the index and the counters. Stages are appended with
+	/// filter, transform, take and drop, which return a new fused sequence.
+	template <IndexedBoundedSequence S, typename ... Stages>
+	class fused_sequence
+	{
+
+		template <IndexedBoundedSequence R, typename ... Others> friend class fused_sequence;
+
+	private:
+
+		S source;
+		std::size_t position = 0;
+		std::tuple<Stages ...> stages;
+
+
+		/// Pushes \a element through the stages from \a I on into \a sink
+		///
+		/// False will be returned, if some stage is exhausted and no further element may pass.
+		template <std::size_t I, typename E, typename K>
+		static constexpr bool feed (std::tuple<Stages ...> & stages, E && element, K & sink)
+		{
+			if constexpr (I == sizeof...(Stages))
+			{
+				return sink(std::forward<E>(element));
+			}
+			else
+			{
+				auto next = [&stages, &sink](auto && passed)
+				{
+					return feed<I + 1>(stages, std::forward<decltype(passed)>(passed), sink);
+				};
+				return std::get<I>(stages).feed(std::forward<E>(element), next);
+			}
+		}
+
+		/// Runs the source elements from \a position through \a stages into \a sink
+		///
+		/// The loop stops when \a sink returns false, or when the source or some stage is
+		/// exhausted. \a position is left behind the last element fed into \a sink, unless some
+		/// stage is exhausted first, in which case it is set to the length of the source.
+		template <typename K>
+		constexpr void run (std::size_t & position, std::tuple<Stages ...> & stages, K & sink) const
+		{
+			const auto length = source.length();
+			auto keepOn = true;
+			auto consumer = [&keepOn, &sink](auto && element)
+			{
+				keepOn = sink(std::forward<decltype(element)>(element));
+				return true;
+			};
+			while (keepOn and position < length)
+			{
+				const auto isFed = feed<0>(stages, source.at(position), consumer);
+				++position;
+				if (not isFed and keepOn)
+					position = length;
+			}
+		}
+
+		template <typename Stage>
+		constexpr fused_sequence<S, Stages ..., Stage> append (Stage stage) const
+		{
+			return fused_sequence<S, Stages ..., Stage>(source, position, std::tuple_cat(stages, std::make_tuple(std::move(stage))));
+		}
+
+	public:
+
+		using value_type = typename fused_result<decltype(std::declval<const S&>().at(0)), Stages ...>::type;
+
+		/// Construction from \a source, the \a position of the next source element and \a stages
+		constexpr fused_sequence (S source, std::size_t position, std::tuple<Stages ...> stages)
+			: source(std::move(source)), position(position), stages(std::move(stages))
+		{}
+
+		/// Appends a stage which passes on elements conforming with \a predictor
+		template <Callable<bool, const value_type&> P>
+		constexpr auto filter (P predictor) const
+		{
+			return append(filter_stage<P>{std::move(predictor)});
+		}
+
+		/// Appends a stage which passes on elements transformed by \a transformer
+		template <Callable_<value_type> T>
+		constexpr auto transform (T transformer) const
+		{
+			return append(transform_stage<T>{std::move(transformer)});
+		}
+
+		/// Appends a stage which passes on the first \a count elements
+		constexpr auto take (std::size_t count) const
+		{
+			return append(take_stage{count});
+		}
+
+		/// Appends a stage which ignores the first \a count elements
+		constexpr auto drop (std::size_t count) const
+		{
+			return append(drop_stage{count});
+		}
+
+		/// In-place advancing
+		///
+		/// The next element passing all stages will be returned, and the sequence will be advanced
+		/// behind it. If there is no such element, an empty optional container will be returned.
+		constexpr optional<value_type> next ()
+		{
+			auto found = optional<value_type>();
+			auto sink = [&found](auto && element)
+			{
+				found = value_type(std::forward<decltype(element)>(element));
+				return false;
+			};
+			run(position, stages, sink);
+			return found;
+		}
+
+		constexpr bool empty () const
+		{
+			auto rest = *this;
+			return not rest.next();
+		}
+
+		constexpr std::size_t length () const
+		{
+			return fold([](std::size_t count, const value_type &)
+			{
+				return count + 1;
+			}, std::size_t(0));
+		}
+
+		/// Prefix decomposition
+		///
+		/// The next element will be returned along with the fused sequence of the succeeding
+		/// elements, which differs only in the source index and the stage counters. As any
+		/// returned sequence, it holds copies of the source and of all stages, so next should be
+		/// preferred for stepping through costly stages.
+		constexpr optional<std::tuple<value_type, fused_sequence>> decompose () const
+		{
+			auto rest = *this;
+			auto element = rest.next();
+			return fmap([&rest](value_type element)
+			{
+				return std::make_tuple(std::move(element), std::move(rest));
+			}, std::move(element));
+		}
+
+		/// Complete folding
+		///
+		/// All elements passing the stages are consecutively folded over \a value by \a combiner
+		/// in a single loop. The completely folded value will be returned.
+		template <typename V, Callable<V, V, value_type> C>
+		constexpr V fold (C combiner, V value) const
+		{
+			auto position = this->position;
+			auto stages = this->stages;
+			auto sink = [&combiner, &value](auto && element)
+			{
+				value = combiner(std::move(value), std::forward<decltype(element)>(element));
+				return true;
+			};
+			run(position, stages, sink);
+			return value;
+		}
+
+		/// Partial folding
+		///
+		/// The elements passing the stages are consecutively folded over \a value by \a combiner
+		/// until it returns a false flag. The folded value will be returned along with the fused
+		/// sequences of the passed elements and of the elements which have not been passed. The
+		/// element which has not been passed is given back to the stages, so the second sequence
+		/// starts with it.
+		template <typename V, Callable<std::tuple<V, bool>, V, value_type> C>
+		constexpr std::tuple<V, fused_sequence, fused_sequence> fold (C combiner, V value) const
+		{
+			auto position = this->position;
+			auto stages = this->stages;
+			auto keepOn = true;
+			auto sink = [&combiner, &value, &keepOn](auto && element)
+			{
+				std::tie(value, keepOn) = combiner(std::move(value), std::forward<decltype(element)>(element));
+				return keepOn;
+			};
+			run(position, stages, sink);
+			if (keepOn)
+				return std::make_tuple(std::move(value), *this, fused_sequence(source, position, std::move(stages)));
+			--position;
+			std::apply([](auto & ... stage)
+			{
+				(stage.unfeed(), ...);
+			}, stages);
+			auto passed = fused_sequence(std::get<0>(source.split(position)), this->position, this->stages);
+			return std::make_tuple(std::move(value), std::move(passed), fused_sequence(source, position, std::move(stages)));
+		}
+
+	};
+
+	/// Returns a fused sequence without any stage over the indexed \a source
+	template <IndexedBoundedSequence S>
+	constexpr fused_sequence<S> fuse (S source)
+	{
+		return fused_sequence<S>(std::move(source), 0, std::tuple<>());
+	}
+
+}
+
+#endif
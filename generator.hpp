@@ -0,0 +1,431 @@
+/// @file generator.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_GENERATOR_HPP__
+#define __STDEXT_GENERATOR_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/array_view.hpp>
+#include <stdext/optional.hpp>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <utility>
+
+namespace stdext
+{
+
+	/// Exception for invalid generator traversals
+	///
+	/// It is thrown when a copy of a generator is used after the coroutine has moved past its
+	/// position, or when an unbounded generator has ended.
+	class generator_error
+	{
+
+		private:
+
+			const char * reason;
+
+		public:
+
+			constexpr explicit generator_error (const char * reason) noexcept
+				: reason(reason)
+			{}
+
+			constexpr const char * what () const
+			{
+				return reason;
+			}
+	};
+
+
+	/// Thread-local pool of coroutine frames
+	///
+	/// Frames are grouped into size classes of powers of two from \a minFrameSize to \a
+	/// maxFrameSize bytes. Released frames are kept in a free list of their class and reused by
+	/// the next coroutine of that class on the same thread, so creating coroutines in a loop does
+	/// not allocate after the first iteration. Larger frames are allocated directly. The pooled
+	/// frames are freed when the thread exits.
+	class frame_pool
+	{
+
+		private:
+
+			static constexpr std::size_t minFrameSize = 64;
+			static constexpr std::size_t maxFrameSize = 8192;
+			static constexpr std::size_t classCount = 8;
+
+			struct free_frame
+			{
+				free_frame * next;
+			};
+
+			free_frame * lists[classCount] = {};
+
+			~frame_pool ()
+			{
+				for (auto * list : lists)
+				{
+					while (list != nullptr)
+					{
+						auto * next = list->next;
+						::operator delete(list);
+						list = next;
+					}
+				}
+			}
+
+			/// Returns the pool of the calling thread
+			static frame_pool & local ()
+			{
+				thread_local frame_pool pool;
+				return pool;
+			}
+
+			/// Returns the size class of frames with \a size bytes
+			static constexpr std::size_t size_class (std::size_t size)
+			{
+				auto index = std::size_t(0);
+				auto classSize = minFrameSize;
+				while (classSize < size)
+				{
+					classSize *= 2;
+					++index;
+				}
+				return index;
+			}
+
+		public:
+
+			/// Returns memory for a frame of \a size bytes
+			static void * allocate (std::size_t size)
+			{
+				if (size > maxFrameSize)
+					return ::operator new(size);
+
+				const auto index = size_class(size);
+				auto & list = local().lists[index];
+				if (list == nullptr)
+					return ::operator new(minFrameSize << index);
+
+				auto * frame = list;
+				list = frame->next;
+				return frame;
+			}
+
+			/// Releases the memory of a \a frame of \a size bytes into the pool
+			static void deallocate (void * frame, std::size_t size) noexcept
+			{
+				if (size > maxFrameSize)
+				{
+					::operator delete(frame);
+					return;
+				}
+
+				auto & list = local().lists[size_class(size)];
+				list = new (frame) free_frame{list};
+			}
+	};
+
+
+	/// Sequence of values produced by a coroutine
+	///
+	/// A function returning a generator becomes a coroutine which produces values with co_yield.
+	/// Single values are yielded by reference, and batches of values are yielded as array views,
+	/// which are handed out to chunked folding as they are. The yielded values must stay alive
+	/// until the coroutine is resumed, which is given for temporaries and local variables. The
+	/// coroutine runs lazily, as far as the values are needed. Frames are taken from the frame
+	/// pool of the thread.
+	///
+	/// A bounded generator ends when its coroutine returns. An unbounded generator, with \a
+	/// IsBounded being false, must never return. All copies of a generator share the coroutine,
+	/// so traversal is single-pass: once the coroutine has been resumed, copies positioned before
+	/// the current batch cannot be used anymore, and using them throws \a generator_error.
+	/// Exceptions thrown by the coroutine are thrown again by the traversal which resumed it.
+	template <typename T, bool IsBounded = true>
+	class generator
+	{
+
+		public:
+
+			struct promise_type
+			{
+				const T * values = nullptr;
+				std::size_t count = 0;
+				std::size_t begin = 0;
+				std::size_t references = 1;
+				std::exception_ptr exception;
+
+				generator get_return_object () noexcept
+				{
+					return generator(std::coroutine_handle<promise_type>::from_promise(*this), 0, std::size_t(-1));
+				}
+
+				std::suspend_always initial_suspend () const noexcept
+				{
+					return {};
+				}
+
+				std::suspend_always final_suspend () const noexcept
+				{
+					return {};
+				}
+
+				std::suspend_always yield_value (const T & value) noexcept
+				{
+					values = std::addressof(value);
+					count = 1;
+					return {};
+				}
+
+				std::suspend_always yield_value (T && value) noexcept
+				{
+					values = std::addressof(value);
+					count = 1;
+					return {};
+				}
+
+				std::suspend_always yield_value (array_view<const T> batch) noexcept
+				{
+					values = batch.data();
+					count = batch.length();
+					return {};
+				}
+
+				std::suspend_always yield_value (array_view<T> batch) noexcept
+				{
+					values = batch.data();
+					count = batch.length();
+					return {};
+				}
+
+				void return_void () const noexcept
+				{}
+
+				void unhandled_exception () noexcept
+				{
+					exception = std::current_exception();
+				}
+
+				static void * operator new (std::size_t size)
+				{
+					return frame_pool::allocate(size);
+				}
+
+				static void operator delete (void * frame, std::size_t size) noexcept
+				{
+					frame_pool::deallocate(frame, size);
+				}
+			};
+
+		private:
+
+			using handle_type = std::coroutine_handle<promise_type>;
+
+			handle_type coroutine;
+			std::size_t position = 0;
+			std::size_t end = std::size_t(-1);
+
+
+			generator (handle_type coroutine, std::size_t position, std::size_t end) noexcept
+				: coroutine(coroutine), position(position), end(end)
+			{}
+
+			/// Returns a generator sharing the coroutine from \a position to \a end
+			generator at_position (std::size_t position, std::size_t end) const noexcept
+			{
+				++coroutine.promise().references;
+				return generator(coroutine, position, end);
+			}
+
+			/// Resumes the coroutine until the value at \a offset is yielded and returns whether
+			/// it exists before the end
+			bool reach (std::size_t offset) const
+			{
+				if (offset >= end)
+					return false;
+				auto & promise = coroutine.promise();
+				if (offset < promise.begin)
+					throw generator_error("values are not yielded anymore");
+				while (offset >= promise.begin + promise.count and not coroutine.done())
+				{
+					promise.begin += promise.count;
+					promise.count = 0;
+					coroutine.resume();
+					if (promise.exception)
+						std::rethrow_exception(std::exchange(promise.exception, nullptr));
+				}
+				return offset < promise.begin + promise.count;
+			}
+
+			/// Returns the value at \a offset of the yielded batch
+			const T & value_at (std::size_t offset) const
+			{
+				const auto & promise = coroutine.promise();
+				if (offset < promise.begin or offset >= promise.begin + promise.count)
+					throw generator_error("values are not yielded anymore");
+				return promise.values[offset - promise.begin];
+			}
+
+			/// Returns the end of the yielded batch, limited by the end of the generator
+			std::size_t batch_end () const
+			{
+				const auto & promise = coroutine.promise();
+				const auto last = promise.begin + promise.count;
+				return last < end ? last : end;
+			}
+
+			/// Folds the values over \a value by \a combiner until it returns a false flag and
+			/// returns the offset of the first value which has not been passed
+			template <typename V, typename C>
+			std::size_t pass (C & combiner, V & value) const
+			{
+				auto offset = position;
+				auto keepOn = true;
+				while (keepOn and reach(offset))
+				{
+					std::tie(value, keepOn) = combiner(std::move(value), value_at(offset));
+					if (keepOn) ++offset;
+				}
+				return offset;
+			}
+
+		public:
+
+			using value_type = T;
+
+			/// Copy constructor
+			///
+			/// The coroutine is shared with \a other.
+			generator (const generator & other) noexcept
+				: coroutine(other.coroutine), position(other.position), end(other.end)
+			{
+				if (coroutine)
+					++coroutine.promise().references;
+			}
+
+			/// Move constructor
+			generator (generator && other) noexcept
+				: coroutine(std::exchange(other.coroutine, nullptr)), position(other.position), end(other.end)
+			{}
+
+			/// Copy and move assignment
+			generator& operator = (generator other) noexcept
+			{
+				std::swap(coroutine, other.coroutine);
+				std::swap(position, other.position);
+				std::swap(end, other.end);
+				return *this;
+			}
+
+			/// Destructor
+			///
+			/// The coroutine frame is destroyed with the last generator sharing it.
+			~generator ()
+			{
+				if (coroutine and --coroutine.promise().references == 0)
+					coroutine.destroy();
+			}
+
+			bool empty () const
+				requires IsBounded
+			{
+				return not reach(position);
+			}
+
+			optional<std::tuple<T, generator>> decompose () const
+				requires IsBounded
+			{
+				using U = optional<std::tuple<T, generator>>;
+				if (not reach(position))
+					return U();
+				return U(std::make_tuple(value_at(position), at_position(position + 1, end)));
+			}
+
+			std::tuple<T, generator> decompose () const
+				requires (not IsBounded)
+			{
+				if (not reach(position))
+					throw generator_error("unbounded generator has ended");
+				return std::make_tuple(value_at(position), at_position(position + 1, end));
+			}
+
+			/// Complete folding
+			///
+			/// All remaining values are consecutively folded over \a value by \a combiner. Each
+			/// yielded batch is traversed in a tight loop.
+			template <typename V, Callable<V, V, const T&> C>
+				requires IsBounded
+			V fold (C combiner, V value) const
+			{
+				auto offset = position;
+				while (reach(offset))
+				{
+					const auto & promise = coroutine.promise();
+					const auto last = batch_end();
+					for (; offset < last; ++offset)
+						value = combiner(std::move(value), promise.values[offset - promise.begin]);
+				}
+				return value;
+			}
+
+			/// Partial folding
+			///
+			/// The remaining values are consecutively folded over \a value by \a combiner until it
+			/// returns a false flag. The folded value will be returned along with the generators of
+			/// the passed values and of the values which have not been passed. The passed values
+			/// can only be traversed again as long as they belong to the current batch.
+			template <typename V, Callable<std::tuple<V, bool>, V, const T&> C>
+				requires IsBounded
+			std::tuple<V, generator, generator> fold (C combiner, V value) const
+			{
+				const auto offset = pass(combiner, value);
+				return std::make_tuple(std::move(value), at_position(position, offset), at_position(offset, end));
+			}
+
+			/// Partial folding
+			///
+			/// The values are consecutively folded over \a value by \a combiner until it returns
+			/// a false flag. The folded value and the generator of the values which have not been
+			/// passed are returned.
+			template <typename V, Callable<std::tuple<V, bool>, V, const T&> C>
+				requires (not IsBounded)
+			std::tuple<V, generator> fold (C combiner, V value) const
+			{
+				const auto offset = pass(combiner, value);
+				return std::make_tuple(std::move(value), at_position(offset, end));
+			}
+
+			/// Chunked folding
+			///
+			/// Each yielded batch of remaining values is folded over \a value by \a combiner as a
+			/// view. A single yielded value forms a batch of its own. See the concept
+			/// ChunkedSequence.
+			template <typename V, Callable<V, V, array_view<const T>> C>
+				requires IsBounded
+			V fold_chunks (C combiner, V value) const
+			{
+				auto offset = position;
+				while (reach(offset))
+				{
+					const auto & promise = coroutine.promise();
+					const auto skipped = offset - promise.begin;
+					const auto last = batch_end();
+					value = combiner(std::move(value), array_view<const T>(promise.values + skipped, last - offset));
+					offset = last;
+				}
+				return value;
+			}
+	};
+
+	/// Generator whose coroutine never returns
+	template <typename T>
+	using unbounded_generator = generator<T, false>;
+
+}
+
+#endif
@@ -0,0 +1,519 @@
+/// @file hash.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_HASH_HPP__
+#define __STDEXT_HASH_HPP__
+
+#include <stdext/array_view.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace stdext
+{
+
+	/// Result of 128 bit hashing
+	struct hash128_value
+	{
+		std::uint64_t low = 0;
+		std::uint64_t high = 0;
+
+		constexpr bool operator == (const hash128_value & other) const
+		{
+			return low == other.low and high == other.high;
+		}
+
+		constexpr bool operator != (const hash128_value & other) const
+		{
+			return not (*this == other);
+		}
+	};
+
+
+	/// Building blocks of the hash functions
+	///
+	/// Inputs up to 128 bytes are mixed by a few full 64 bit multiplications. Longer inputs are
+	/// split into stripes of 64 bytes which are accumulated into eight independent lanes, so the
+	/// accumulation runs on vector registers. The lanes are scrambled after each block of stripes
+	/// and merged at the end. Values are read in the byte order of the processor, so hashes are
+	/// equal among processors with equal byte order only.
+	class hash_kernel
+	{
+
+	public:
+
+		static constexpr std::size_t secretSize = 192;
+		static constexpr std::size_t stripeSize = 64;
+		static constexpr std::size_t stripesPerBlock = (secretSize - stripeSize) / 8;
+		static constexpr std::size_t maxShortLength = 128;
+
+		static constexpr std::uint64_t prime32_1 = 0x9E3779B1U;
+		static constexpr std::uint64_t prime32_2 = 0x85EBCA77U;
+		static constexpr std::uint64_t prime32_3 = 0xC2B2AE3DU;
+		static constexpr std::uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+		static constexpr std::uint64_t prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+		static constexpr std::uint64_t prime64_3 = 0x165667B19E3779F9ULL;
+		static constexpr std::uint64_t prime64_4 = 0x85EBCA77C2B2AE63ULL;
+		static constexpr std::uint64_t prime64_5 = 0x27D4EB2F165667C5ULL;
+
+		using secret_type = std::array<unsigned char, secretSize>;
+		using accumulator_type = std::array<std::uint64_t, 8>;
+
+
+		/// Returns the default secret, which is generated by splitmix64
+		static constexpr secret_type default_secret ()
+		{
+			auto secret = secret_type();
+			auto state = prime64_1;
+			for (std::size_t word = 0; word < secretSize / 8; ++word)
+			{
+				state += 0x9E3779B97F4A7C15ULL;
+				auto z = state;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+				z = z ^ (z >> 31);
+				for (std::size_t byte = 0; byte < 8; ++byte)
+					secret[word * 8 + byte] = static_cast<unsigned char>(z >> (byte * 8));
+			}
+			return secret;
+		}
+
+		/// Returns the secret for \a seed, which is the default secret with the seed added to even
+		/// and subtracted from odd words
+		///
+		/// Only long inputs are hashed with a seeded secret, short ones mix the seed in directly.
+		static secret_type seeded_secret (std::uint64_t seed)
+		{
+			static constexpr auto secret = default_secret();
+			auto seeded = secret;
+			for (std::size_t word = 0; word < secretSize / 8; ++word)
+			{
+				const auto value = read64(secret.data() + word * 8) + (word % 2 == 0 ? seed : 0 - seed);
+				std::memcpy(seeded.data() + word * 8, &value, 8);
+			}
+			return seeded;
+		}
+
+		static std::uint64_t read64 (const unsigned char * bytes)
+		{
+			auto value = std::uint64_t(0);
+			std::memcpy(&value, bytes, 8);
+			return value;
+		}
+
+		static std::uint32_t read32 (const unsigned char * bytes)
+		{
+			auto value = std::uint32_t(0);
+			std::memcpy(&value, bytes, 4);
+			return value;
+		}
+
+		static constexpr std::uint64_t rotate_left (std::uint64_t value, unsigned count)
+		{
+			return (value << count) | (value >> (64 - count));
+		}
+
+		static constexpr std::uint64_t swap_bytes (std::uint64_t value)
+		{
+			value = ((value & 0x00FF00FF00FF00FFULL) << 8) | ((value >> 8) & 0x00FF00FF00FF00FFULL);
+			value = ((value & 0x0000FFFF0000FFFFULL) << 16) | ((value >> 16) & 0x0000FFFF0000FFFFULL);
+			return (value << 32) | (value >> 32);
+		}
+
+		/// Multiplies \a a and \a b to 128 bits and folds the halves
+		static constexpr std::uint64_t multiply_fold (std::uint64_t a, std::uint64_t b)
+		{
+#if defined(__SIZEOF_INT128__)
+			const auto product = static_cast<unsigned __int128>(a) * b;
+			return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+			const auto aLow = a & 0xFFFFFFFFU;
+			const auto aHigh = a >> 32;
+			const auto bLow = b & 0xFFFFFFFFU;
+			const auto bHigh = b >> 32;
+			const auto lowLow = aLow * bLow;
+			const auto highLow = aHigh * bLow;
+			const auto lowHigh = aLow * bHigh;
+			const auto highHigh = aHigh * bHigh;
+			const auto cross = (lowLow >> 32) + (highLow & 0xFFFFFFFFU) + lowHigh;
+			const auto upper = (highLow >> 32) + (cross >> 32) + highHigh;
+			const auto lower = (cross << 32) | (lowLow & 0xFFFFFFFFU);
+			return lower ^ upper;
+#endif
+		}
+
+		static constexpr std::uint64_t avalanche (std::uint64_t hash)
+		{
+			hash ^= hash >> 37;
+			hash *= 0x165667919E3779F9ULL;
+			return hash ^ (hash >> 32);
+		}
+
+		static constexpr std::uint64_t avalanche_strong (std::uint64_t hash, std::uint64_t length)
+		{
+			hash ^= rotate_left(hash, 49) ^ rotate_left(hash, 24);
+			hash *= 0x9FB21C651E98DF25ULL;
+			hash ^= (hash >> 35) + length;
+			hash *= 0x9FB21C651E98DF25ULL;
+			return hash ^ (hash >> 28);
+		}
+
+		static constexpr std::uint64_t avalanche_small (std::uint64_t hash)
+		{
+			hash ^= hash >> 33;
+			hash *= prime64_2;
+			hash ^= hash >> 29;
+			hash *= prime64_3;
+			return hash ^ (hash >> 32);
+		}
+
+		/// Mixes 16 \a bytes with 16 bytes of \a secret
+		static std::uint64_t mix16 (const unsigned char * bytes, const unsigned char * secret, std::uint64_t seed)
+		{
+			return multiply_fold(read64(bytes) ^ (read64(secret) + seed), read64(bytes + 8) ^ (read64(secret + 8) - seed));
+		}
+
+		/// Hashes up to \a maxShortLength \a bytes
+		static std::uint64_t hash_short (const unsigned char * bytes, std::size_t length, const unsigned char * secret, std::uint64_t seed)
+		{
+			if (length > 16)
+			{
+				auto hash = length * prime64_1;
+				const auto pairs = (length - 1) / 32 + 1;
+				for (std::size_t pair = 0; pair < pairs; ++pair)
+				{
+					hash += mix16(bytes + pair * 16, secret + pair * 32, seed);
+					hash += mix16(bytes + length - 16 - pair * 16, secret + pair * 32 + 16, seed);
+				}
+				return avalanche(hash);
+			}
+			else if (length > 8)
+			{
+				const auto low = read64(bytes) ^ ((read64(secret + 24) ^ read64(secret + 32)) + seed);
+				const auto high = read64(bytes + length - 8) ^ ((read64(secret + 40) ^ read64(secret + 48)) - seed);
+				return avalanche(length + swap_bytes(low) + high + multiply_fold(low, high));
+			}
+			else if (length >= 4)
+			{
+				const auto input = read32(bytes + length - 4) + (std::uint64_t(read32(bytes)) << 32);
+				const auto flip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+				return avalanche_strong(input ^ flip, length);
+			}
+			else if (length > 0)
+			{
+				const auto combined = (std::uint64_t(bytes[0]) << 16) | (std::uint64_t(bytes[length / 2]) << 24)
+					| std::uint64_t(bytes[length - 1]) | (std::uint64_t(length) << 8);
+				const auto flip = (std::uint64_t(read32(secret)) ^ read32(secret + 4)) + seed;
+				return avalanche_small(combined ^ flip);
+			}
+			else
+			{
+				return avalanche_small(seed ^ read64(secret + 56) ^ read64(secret + 64));
+			}
+		}
+
+		/// Returns the initial lanes of accumulation
+		static constexpr accumulator_type initial_accumulator ()
+		{
+			return {prime32_3, prime64_1, prime64_2, prime64_3, prime64_4, prime32_2, prime64_5, prime32_1};
+		}
+
+		/// Accumulates one stripe of \a bytes with the \a secret at the stripe's offset
+		///
+		/// Each lane adds the product of the low and high half of its input xored with the secret,
+		/// and the neighbouring lane adds the plain input.
+		static void accumulate (accumulator_type & accumulator, const unsigned char * bytes, const unsigned char * secret)
+		{
+#if defined(__SSE2__)
+			for (std::size_t pair = 0; pair < 4; ++pair)
+			{
+				auto lanes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(accumulator.data() + pair * 2));
+				const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + pair * 16));
+				const auto key = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret + pair * 16)));
+				const auto product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, 0xB1));
+				lanes = _mm_add_epi64(lanes, _mm_shuffle_epi32(data, 0x4E));
+				lanes = _mm_add_epi64(lanes, product);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(accumulator.data() + pair * 2), lanes);
+			}
+#else
+			for (std::size_t lane = 0; lane < 8; ++lane)
+			{
+				const auto data = read64(bytes + lane * 8);
+				const auto key = data ^ read64(secret + lane * 8);
+				accumulator[lane ^ 1] += data;
+				accumulator[lane] += (key & 0xFFFFFFFFU) * (key >> 32);
+			}
+#endif
+		}
+
+		/// Scrambles all lanes with the last 64 bytes of the \a secret
+		static void scramble (accumulator_type & accumulator, const unsigned char * secret)
+		{
+			for (std::size_t lane = 0; lane < 8; ++lane)
+			{
+				auto value = accumulator[lane];
+				value ^= value >> 47;
+				value ^= read64(secret + secretSize - stripeSize + lane * 8);
+				accumulator[lane] = value * prime32_1;
+			}
+		}
+
+		/// Accumulates \a count stripes of \a bytes, continuing at stripe \a stripe of a block
+		///
+		/// The index of the stripe within its block after accumulation will be returned.
+		static std::size_t accumulate_stripes (accumulator_type & accumulator, const unsigned char * bytes, std::size_t count, std::size_t stripe, const unsigned char * secret)
+		{
+			for (std::size_t index = 0; index < count; ++index)
+			{
+				accumulate(accumulator, bytes + index * stripeSize, secret + stripe * 8);
+				if (++stripe == stripesPerBlock)
+				{
+					scramble(accumulator, secret);
+					stripe = 0;
+				}
+			}
+			return stripe;
+		}
+
+		/// Accumulates the last stripe, which are the 64 bytes ending at \a end
+		static void accumulate_last (accumulator_type & accumulator, const unsigned char * end, const unsigned char * secret)
+		{
+			accumulate(accumulator, end - stripeSize, secret + secretSize - stripeSize - 7);
+		}
+
+		/// Merges all lanes into a single hash, starting with \a hash and the \a secret at \a offset
+		static std::uint64_t merge (const accumulator_type & accumulator, const unsigned char * secret, std::size_t offset, std::uint64_t hash)
+		{
+			for (std::size_t pair = 0; pair < 4; ++pair)
+			{
+				const auto key = secret + offset + pair * 16;
+				hash += multiply_fold(accumulator[pair * 2] ^ read64(key), accumulator[pair * 2 + 1] ^ read64(key + 8));
+			}
+			return avalanche(hash);
+		}
+
+		/// Returns the 64 bit hash of accumulated lanes for \a length bytes
+		static std::uint64_t finish64 (const accumulator_type & accumulator, std::size_t length, const unsigned char * secret)
+		{
+			return merge(accumulator, secret, 11, length * prime64_1);
+		}
+
+		/// Returns the 128 bit hash of accumulated lanes for \a length bytes
+		static hash128_value finish128 (const accumulator_type & accumulator, std::size_t length, const unsigned char * secret)
+		{
+			const auto low = merge(accumulator, secret, 11, length * prime64_1);
+			const auto high = merge(accumulator, secret, secretSize - stripeSize - 11, ~(length * prime64_2));
+			return hash128_value{low, high};
+		}
+
+		/// Accumulates all stripes of more than \a maxShortLength \a bytes
+		static accumulator_type accumulate_long (const unsigned char * bytes, std::size_t length, const unsigned char * secret)
+		{
+			auto accumulator = initial_accumulator();
+			accumulate_stripes(accumulator, bytes, (length - 1) / stripeSize, 0, secret);
+			accumulate_last(accumulator, bytes + length, secret);
+			return accumulator;
+		}
+
+	};
+
+
+	/// 64 bit hashing
+	///
+	/// The bytes of all values in \a view will be hashed with \a seed. The hash is fast but not
+	/// cryptographic. Long views are accumulated in vector registers.
+	///
+	/// @param view  View on trivially copyable values
+	/// @param seed  Seed which yields independent hash functions
+	///
+	/// @note Time complexity is linear in the length of the view.
+	///
+	template <typename T>
+	std::uint64_t hash64 (array_view<const T> view, std::uint64_t seed = 0)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Values must be trivially copyable for hashing!");
+
+		static constexpr auto defaultSecret = hash_kernel::default_secret();
+		const auto bytes = reinterpret_cast<const unsigned char *>(view.data());
+		const auto length = view.length() * sizeof(T);
+		if (length <= hash_kernel::maxShortLength)
+			return hash_kernel::hash_short(bytes, length, defaultSecret.data(), seed);
+
+		if (seed == 0)
+			return hash_kernel::finish64(hash_kernel::accumulate_long(bytes, length, defaultSecret.data()), length, defaultSecret.data());
+
+		const auto secret = hash_kernel::seeded_secret(seed);
+		return hash_kernel::finish64(hash_kernel::accumulate_long(bytes, length, secret.data()), length, secret.data());
+	}
+
+	/// 128 bit hashing
+	///
+	/// The bytes of all values in \a view will be hashed with \a seed. Short views are hashed twice
+	/// with different seeds, while the lanes of long views are merged twice with different
+	/// secrets.
+	///
+	/// @param view  View on trivially copyable values
+	/// @param seed  Seed which yields independent hash functions
+	///
+	/// @note Time complexity is linear in the length of the view.
+	///
+	template <typename T>
+	hash128_value hash128 (array_view<const T> view, std::uint64_t seed = 0)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Values must be trivially copyable for hashing!");
+
+		static constexpr auto defaultSecret = hash_kernel::default_secret();
+		const auto bytes = reinterpret_cast<const unsigned char *>(view.data());
+		const auto length = view.length() * sizeof(T);
+		if (length <= hash_kernel::maxShortLength)
+		{
+			const auto low = hash_kernel::hash_short(bytes, length, defaultSecret.data(), seed);
+			const auto high = hash_kernel::hash_short(bytes, length, defaultSecret.data(), seed ^ hash_kernel::prime64_4);
+			return hash128_value{low, high};
+		}
+
+		if (seed == 0)
+			return hash_kernel::finish128(hash_kernel::accumulate_long(bytes, length, defaultSecret.data()), length, defaultSecret.data());
+
+		const auto secret = hash_kernel::seeded_secret(seed);
+		return hash_kernel::finish128(hash_kernel::accumulate_long(bytes, length, secret.data()), length, secret.data());
+	}
+
+
+	/// Hashing of data arriving in chunks
+	///
+	/// Chunks of values are appended with \a update, and the hash of all appended bytes can be
+	/// taken at any time. The hashes equal those of hash64 and hash128 for all bytes at once with
+	/// the same seed, regardless of how the bytes are split into chunks.
+	class streaming_hasher
+	{
+
+	private:
+
+		static constexpr std::size_t bufferSize = 4 * hash_kernel::stripeSize;
+
+		hash_kernel::secret_type secret;
+		hash_kernel::accumulator_type accumulator = hash_kernel::initial_accumulator();
+		std::array<unsigned char, bufferSize> buffer = {};
+		std::size_t buffered = 0;
+		std::size_t stripe = 0;
+		std::size_t total = 0;
+		std::uint64_t seed = 0;
+
+
+		/// Accumulates the stripes which have not been accumulated yet
+		///
+		/// The last stripe of the buffered bytes is accumulated as last stripe. If less than a
+		/// stripe is buffered, the last stripe reaches into bytes of the previous buffer.
+		hash_kernel::accumulator_type accumulate_rest () const
+		{
+			auto accumulator = this->accumulator;
+			hash_kernel::accumulate_stripes(accumulator, buffer.data(), (buffered - 1) / hash_kernel::stripeSize, stripe, secret.data());
+			if (buffered >= hash_kernel::stripeSize)
+			{
+				hash_kernel::accumulate_last(accumulator, buffer.data() + buffered, secret.data());
+			}
+			else
+			{
+				auto last = std::array<unsigned char, hash_kernel::stripeSize>();
+				const auto previous = hash_kernel::stripeSize - buffered;
+				std::memcpy(last.data(), buffer.data() + bufferSize - previous, previous);
+				std::memcpy(last.data() + previous, buffer.data(), buffered);
+				hash_kernel::accumulate_last(accumulator, last.data() + hash_kernel::stripeSize, secret.data());
+			}
+			return accumulator;
+		}
+
+	public:
+
+		/// Constructs a hasher with \a seed
+		explicit streaming_hasher (std::uint64_t seed = 0)
+			: secret(seed == 0 ? hash_kernel::default_secret() : hash_kernel::seeded_secret(seed)), seed(seed)
+		{}
+
+		/// Appends the bytes of all values in \a view
+		template <typename T>
+		void update (array_view<const T> view)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Values must be trivially copyable for hashing!");
+
+			auto bytes = reinterpret_cast<const unsigned char *>(view.data());
+			auto length = view.length() * sizeof(T);
+			total += length;
+			while (length > 0)
+			{
+				// a full buffer is only accumulated when more bytes follow, so the last stripe stays
+				if (buffered == bufferSize)
+				{
+					stripe = hash_kernel::accumulate_stripes(accumulator, buffer.data(), bufferSize / hash_kernel::stripeSize, stripe, secret.data());
+					buffered = 0;
+				}
+
+				const auto count = length < bufferSize - buffered ? length : bufferSize - buffered;
+				std::memcpy(buffer.data() + buffered, bytes, count);
+				buffered += count;
+				bytes += count;
+				length -= count;
+			}
+		}
+
+		/// Returns the 64 bit hash of all appended bytes
+		std::uint64_t digest64 () const
+		{
+			static constexpr auto defaultSecret = hash_kernel::default_secret();
+			if (total <= hash_kernel::maxShortLength)
+				return hash_kernel::hash_short(buffer.data(), total, defaultSecret.data(), seed);
+			return hash_kernel::finish64(accumulate_rest(), total, secret.data());
+		}
+
+		/// Returns the 128 bit hash of all appended bytes
+		hash128_value digest128 () const
+		{
+			static constexpr auto defaultSecret = hash_kernel::default_secret();
+			if (total <= hash_kernel::maxShortLength)
+			{
+				const auto low = hash_kernel::hash_short(buffer.data(), total, defaultSecret.data(), seed);
+				const auto high = hash_kernel::hash_short(buffer.data(), total, defaultSecret.data(), seed ^ hash_kernel::prime64_4);
+				return hash128_value{low, high};
+			}
+			return hash_kernel::finish128(accumulate_rest(), total, secret.data());
+		}
+
+	};
+
+
+	/// Hasher for dictionaries
+	///
+	/// Views are hashed by the bytes of their values, and other trivially copyable keys by their
+	/// object representation, which must not contain padding. The hasher can be passed as \a H to
+	/// basic_dictionary.
+	struct hasher
+	{
+
+		std::uint64_t seed = 0;
+
+		template <typename T>
+		std::size_t operator () (array_view<T> view) const
+		{
+			return static_cast<std::size_t>(hash64(array_view<const T>(view.data(), view.length()), seed));
+		}
+
+		template <typename K>
+			requires std::is_trivially_copyable<K>::value
+		std::size_t operator () (const K & key) const
+		{
+			return static_cast<std::size_t>(hash64(array_view<const K>(&key, 1), seed));
+		}
+
+	};
+
+}
+
+#endif
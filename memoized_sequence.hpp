@@ -0,0 +1,198 @@
+/// @file memoized_sequence.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_MEMOIZED_SEQUENCE_HPP__
+#define __STDEXT_MEMOIZED_SEQUENCE_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/allocator.hpp>
+#include <stdext/array.hpp>
+#include <stdext/optional.hpp>
+#include <stdext/sequence.hpp>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace stdext
+{
+
+	/// Memoizing sequencer for bounded sequences
+	///
+	/// The sequencer materializes the elements of the held sequence lazily into an array, one
+	/// chunk of \a sequenceChunkLength elements at a time, as soon as they are needed. All copies
+	/// of the sequencer, including the ones returned by decomposition and folding, share the
+	/// materialized elements and differ only in their position. So each element is computed
+	/// once, e.g. each predicate of a filter is evaluated once, and later traversals, length and
+	/// decomposition read the cached elements. Only the element following a chunk is computed
+	/// twice, as folding the chunk has to look at it to stop, and it is computed again as the
+	/// first element of the next chunk. Memory is allocated from \a A. The sequencer must not be
+	/// used concurrently.
+	template <BoundedSequence S, Allocator A = system_allocator>
+	class memoized_sequence
+	{
+
+	public:
+
+		using value_type = std::decay_t<sequence_type_t<S>>;
+
+	private:
+
+		struct cache
+		{
+			S rest;
+			array<value_type, A> values;
+			bool exhausted = false;
+
+			cache (S sequence, A allocator)
+				: rest(std::move(sequence)), values(std::move(allocator))
+			{}
+
+			/// Materializes the next chunk of elements, unless the held sequence is exhausted
+			///
+			/// If an exception is thrown, the elements of the chunk are erased again, so the cache
+			/// remains in its previous state.
+			void materialize ()
+			{
+				if (exhausted)
+					return;
+
+				const auto cached = values.length();
+				try
+				{
+					auto folding = rest.fold([this](std::size_t count, auto element)
+					{
+						const auto isInBound = count < sequenceChunkLength;
+						if (isInBound)
+							values.append(std::move(element));
+						return std::make_tuple(count + (isInBound ? 1 : 0), isInBound);
+					}, std::size_t(0));
+					exhausted = std::get<0>(folding) < sequenceChunkLength;
+					rest = std::move(std::get<2>(folding));
+				}
+				catch (...)
+				{
+					values.erase(cached, values.length() - cached);
+					throw;
+				}
+			}
+
+			/// Materializes chunks until the element at \a index is cached or the held sequence is
+			/// exhausted, and returns whether the element exists
+			bool reach (std::size_t index)
+			{
+				while (index >= values.length() and not exhausted)
+					materialize();
+				return index < values.length();
+			}
+		};
+
+		std::shared_ptr<cache> memory;
+		std::size_t position = 0;
+		std::size_t end = std::size_t(-1);
+
+		memoized_sequence (std::shared_ptr<cache> memory, std::size_t position, std::size_t end)
+			: memory(std::move(memory)), position(position), end(end)
+		{}
+
+		/// Materializes the element at \a index and returns whether it exists before the end
+		bool reach (std::size_t index) const
+		{
+			return index < end and memory->reach(index);
+		}
+
+	public:
+
+		/// Construction from \a sequence with \a allocator
+		///
+		/// No element will be materialized until it is needed.
+		memoized_sequence (S sequence, A allocator)
+			: memory(std::make_shared<cache>(std::move(sequence), std::move(allocator)))
+		{}
+
+		bool empty () const
+		{
+			return not reach(position);
+		}
+
+		/// Returns the amount of remaining elements
+		///
+		/// All elements will be materialized by the first call.
+		std::size_t length () const
+		{
+			memory->reach(end);
+			const auto count = memory->values.length();
+			return (count < end ? count : end) - position;
+		}
+
+		optional<std::tuple<value_type, memoized_sequence>> decompose () const
+		{
+			using U = optional<std::tuple<value_type, memoized_sequence>>;
+			if (not reach(position))
+				return U();
+			return U(std::make_tuple(memory->values.data()[position], memoized_sequence(memory, position + 1, end)));
+		}
+
+		/// Complete folding
+		///
+		/// All remaining elements are consecutively folded over \a value by \a combiner. Cached
+		/// elements are read from the array, the others are materialized chunk by chunk.
+		template <typename V, Callable<V, V, const value_type&> C>
+		V fold (C combiner, V value) const
+		{
+			auto index = position;
+			while (reach(index))
+			{
+				const auto count = memory->values.length();
+				const auto last = count < end ? count : end;
+				for (; index < last; ++index)
+					value = combiner(std::move(value), memory->values.data()[index]);
+			}
+			return value;
+		}
+
+		/// Partial folding
+		///
+		/// The remaining elements are consecutively folded over \a value by \a combiner until it
+		/// returns a false flag. The folded value will be returned along with the sequencers of the
+		/// passed elements and of the elements which have not been passed. All of them share the
+		/// cache.
+		template <typename V, Callable<std::tuple<V, bool>, V, const value_type&> C>
+		std::tuple<V, memoized_sequence, memoized_sequence> fold (C combiner, V value) const
+		{
+			auto index = position;
+			auto keepOn = true;
+			while (keepOn and reach(index))
+			{
+				std::tie(value, keepOn) = combiner(std::move(value), memory->values.data()[index]);
+				if (keepOn) ++index;
+			}
+			return std::make_tuple(std::move(value), memoized_sequence(memory, position, index), memoized_sequence(memory, index, end));
+		}
+
+	};
+
+	/// Memoization of \a sequence with \a allocator
+	///
+	/// A sequencer will be returned which computes each element of \a sequence once, besides the
+	/// element following each chunk, and caches it in an array from \a allocator.
+	template <BoundedSequence S, Allocator A>
+	memoized_sequence<S, A> memoize (S sequence, A allocator)
+	{
+		return memoized_sequence<S, A>(std::move(sequence), std::move(allocator));
+	}
+
+	/// Memoization of \a sequence
+	///
+	/// The cache is allocated from the system allocator.
+	template <BoundedSequence S>
+	memoized_sequence<S> memoize (S sequence)
+	{
+		return memoized_sequence<S>(std::move(sequence), system_allocator());
+	}
+
+}
+
+#endif
@@ -0,0 +1,350 @@
+/// @file merge.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_MERGE_HPP__
+#define __STDEXT_MERGE_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/allocator.hpp>
+#include <stdext/array_view.hpp>
+#include <stdext/optional.hpp>
+#include <tuple>
+#include <utility>
+
+namespace stdext
+{
+
+	/// Loser tree over sorted views
+	///
+	/// The tree holds a cursor for each of several views which are sorted by \a C. The least head
+	/// value of all views is found at the root, and after advancing its view, only the path from
+	/// its leaf to the root is replayed. Hence, advancing costs the logarithm of the amount of
+	/// views in comparisons. Equivalent values are taken from views with lower index first, so
+	/// merging is stable. Memory for the cursors and the tree is allocated from \a A.
+	template <typename T, Callable<bool, const T&, const T&> C, Allocator A = system_allocator>
+	class loser_tree
+	{
+
+	private:
+
+		struct cursor
+		{
+			const T * next = nullptr;
+			const T * end = nullptr;
+		};
+
+		using cursor_allocation_type = allocation_type_t<A, cursor>;
+		using node_allocation_type = allocation_type_t<A, std::size_t>;
+
+		C comparer;
+		A allocator;
+		cursor_allocation_type cursorAllocation;
+		node_allocation_type nodeAllocation;
+		std::size_t count = 0;
+
+
+		/// Allocates cursors and nodes for \a count views
+		void allocate ()
+		{
+			cursorAllocation = allocator.template allocate<cursor>(count);
+			nodeAllocation = allocator.template allocate<std::size_t>(count);
+			if (cursorAllocation.length() < count or nodeAllocation.length() < count)
+			{
+				allocator.deallocate(nodeAllocation);
+				allocator.deallocate(cursorAllocation);
+				throw bad_alloc("loser tree cannot be allocated");
+			}
+		}
+
+		/// Returns whether the head of view \a a comes before the head of view \a b
+		///
+		/// Exhausted views lose against all others, and ties are won by the view with lower index.
+		/// Only a single comparison is performed.
+		bool beats (std::size_t a, std::size_t b) const
+		{
+			const cursor * cursors = cursorAllocation.data();
+			if (cursors[b].next == cursors[b].end)
+				return true;
+			if (cursors[a].next == cursors[a].end)
+				return false;
+			return a < b ? not comparer(*cursors[b].next, *cursors[a].next) : comparer(*cursors[a].next, *cursors[b].next);
+		}
+
+		/// Plays all matches of the subtree at \a node and returns its winner
+		///
+		/// Nodes are numbered from one, with the root being node one and leaves being the nodes \a
+		/// count to 2 \a count - 1. Each inner node keeps the loser of its match.
+		std::size_t initialize (std::size_t node)
+		{
+			if (node >= count)
+				return node - count;
+
+			std::size_t * losers = nodeAllocation.data();
+			const auto left = initialize(node * 2);
+			const auto right = initialize(node * 2 + 1);
+			if (beats(left, right))
+			{
+				losers[node] = right;
+				return left;
+			}
+			else
+			{
+				losers[node] = left;
+				return right;
+			}
+		}
+
+	public:
+
+		/// Construction from sorted \a views with \a comparer and \a allocator
+		///
+		/// The views themselves will not be modified. If not enough memory could be allocated, the
+		/// exception \a bad_alloc will be thrown.
+		loser_tree (array_view<const array_view<const T>> views, C comparer, A allocator)
+			: comparer(std::move(comparer)), allocator(std::move(allocator)), count(views.length())
+		{
+			allocate();
+			cursor * cursors = cursorAllocation.data();
+			for (std::size_t index = 0; index < count; ++index)
+			{
+				const auto & view = views.data()[index];
+				cursors[index] = cursor{view.data(), view.data() + view.length()};
+			}
+			if (count > 0)
+				nodeAllocation.data()[0] = initialize(1);
+		}
+
+		/// Copy constructor
+		///
+		/// Cursors and nodes are copied into memory from a copy of the allocator of \a other.
+		loser_tree (const loser_tree & other)
+			: comparer(other.comparer), allocator(other.allocator), count(other.count)
+		{
+			allocate();
+			for (std::size_t index = 0; index < count; ++index)
+			{
+				cursorAllocation.data()[index] = other.cursorAllocation.data()[index];
+				nodeAllocation.data()[index] = other.nodeAllocation.data()[index];
+			}
+		}
+
+		/// Move constructor
+		///
+		/// Cursors and nodes are taken over from \a other, which will be empty afterwards.
+		loser_tree (loser_tree && other)
+			: comparer(other.comparer), allocator(other.allocator), cursorAllocation(other.cursorAllocation),
+			  nodeAllocation(other.nodeAllocation), count(other.count)
+		{
+			other.cursorAllocation = cursor_allocation_type();
+			other.nodeAllocation = node_allocation_type();
+			other.count = 0;
+		}
+
+		loser_tree& operator = (const loser_tree &) = delete;
+
+		/// Destructor
+		~loser_tree ()
+		{
+			allocator.deallocate(nodeAllocation);
+			allocator.deallocate(cursorAllocation);
+		}
+
+		/// Returns whether all views are exhausted
+		bool empty () const
+		{
+			if (count == 0)
+				return true;
+			const auto & winner = cursorAllocation.data()[nodeAllocation.data()[0]];
+			return winner.next == winner.end;
+		}
+
+		/// Returns the least head value of all views
+		///
+		/// The tree must not be empty.
+		const T & top () const
+		{
+			assert(not empty());
+			return *cursorAllocation.data()[nodeAllocation.data()[0]].next;
+		}
+
+		/// Advances the view holding the least head value
+		///
+		/// The tree must not be empty.
+		void pop ()
+		{
+			assert(not empty());
+
+			using std::swap;
+			std::size_t * losers = nodeAllocation.data();
+			auto winner = losers[0];
+			++cursorAllocation.data()[winner].next;
+			for (auto node = (winner + count) / 2; node > 0; node /= 2)
+			{
+				if (beats(losers[node], winner))
+					swap(losers[node], winner);
+			}
+			losers[0] = winner;
+		}
+
+	};
+
+
+	/// Sequence of merged sorted views
+	///
+	/// The bounded sequence yields all values of several views sorted by \a C in one pass with a
+	/// loser tree. Copying the sequence copies the tree, which is linear in the amount of views,
+	/// so folding should be preferred over repeated decomposition.
+	template <typename T, Callable<bool, const T&, const T&> C, Allocator A = system_allocator>
+	class bounded_merger
+	{
+
+	private:
+
+		loser_tree<T, C, A> tree;
+		std::size_t remaining = 0;
+
+	public:
+
+		using value_type = const T&;
+
+		/// Construction from sorted \a views with \a comparer and \a allocator
+		bounded_merger (array_view<const array_view<const T>> views, C comparer, A allocator)
+			: tree(views, std::move(comparer), std::move(allocator))
+		{
+			for (std::size_t index = 0; index < views.length(); ++index)
+				remaining += views.data()[index].length();
+		}
+
+		bool empty () const
+		{
+			return remaining == 0;
+		}
+
+		std::size_t length () const
+		{
+			return remaining;
+		}
+
+		optional<std::tuple<const T&, bounded_merger>> decompose () const
+		{
+			if (remaining == 0)
+				return optional<std::tuple<const T&, bounded_merger>>();
+
+			auto rest = *this;
+			const T & value = rest.tree.top();
+			rest.tree.pop();
+			--rest.remaining;
+			return optional<std::tuple<const T&, bounded_merger>>(std::tuple<const T&, bounded_merger>(value, std::move(rest)));
+		}
+
+		/// Complete folding
+		///
+		/// All merged values are consecutively folded over \a value by \a combiner in sorted order.
+		/// The completely folded value will be returned.
+		template <typename V, Callable<V, V, value_type> D>
+		V fold (D combiner, V value) const
+		{
+			auto tree = this->tree;
+			for (auto index = remaining; index > 0; --index)
+			{
+				value = combiner(std::move(value), tree.top());
+				tree.pop();
+			}
+			return value;
+		}
+
+		/// Partial folding
+		///
+		/// All merged values are consecutively folded over \a value by \a combiner in sorted order.
+		/// The traversion stops with the first false flag returned by \a combiner. The folded value
+		/// will be returned along with the sequences of the passed values and of the values which
+		/// have not been passed.
+		template <typename V, Callable<std::tuple<V, bool>, V, value_type> D>
+		std::tuple<V, bounded_merger, bounded_merger> fold (D combiner, V value) const
+		{
+			auto rest = *this;
+			auto keepOn = true;
+			while (keepOn and rest.remaining > 0)
+			{
+				std::tie(value, keepOn) = combiner(std::move(value), rest.tree.top());
+				if (keepOn)
+				{
+					rest.tree.pop();
+					--rest.remaining;
+				}
+			}
+			auto passed = *this;
+			passed.remaining -= rest.remaining;
+			return std::make_tuple(std::move(value), std::move(passed), std::move(rest));
+		}
+
+	};
+
+
+	/// K-way merging into \a destination with \a allocator
+	///
+	/// The sorted \a views will be merged in order defined by \a comparer into \a destination in a
+	/// single pass. The order must be strict weak. Equivalent values are taken from views with
+	/// lower index first. Values are copy assigned to \a destination. If \a destination is too
+	/// short, merging stops when it is full. The part of \a destination holding the merged values
+	/// and the remaining part will be returned. The loser tree is allocated from \a allocator.
+	///
+	/// @param comparer     A callable object which takes two constant references of type \a T and
+	///                     returns a boolean indicating if both values are in right order
+	/// @param views        Views which are sorted by \a comparer
+	/// @param destination  View to which the merged values are assigned
+	/// @param allocator    Allocator from which the loser tree is requested
+	///
+	/// @note Time complexity is n*log(k) with n being the amount of merged values and k being the
+	///       amount of views.
+	///
+	template <typename T, Callable<bool, const T&, const T&> C, Allocator A>
+	std::tuple<array_view<T>, array_view<T>> merge_sorted (C comparer, array_view<const array_view<const T>> views, array_view<T> destination, A allocator)
+	{
+		static_assert(not std::is_const<T>::value, "Value of destination must be not const!");
+
+		auto tree = loser_tree<T, C, A>(views, std::move(comparer), std::move(allocator));
+		T * values = destination.data();
+		auto index = std::size_t(0);
+		while (index < destination.length() and not tree.empty())
+		{
+			values[index] = tree.top();
+			tree.pop();
+			++index;
+		}
+		return std::make_tuple(array_view<T>(values, index), array_view<T>(values + index, destination.length() - index));
+	}
+
+	/// K-way merging into \a destination
+	///
+	/// The loser tree is allocated from the system allocator. See merge_sorted with allocator.
+	template <typename T, Callable<bool, const T&, const T&> C>
+	std::tuple<array_view<T>, array_view<T>> merge_sorted (C comparer, array_view<const array_view<const T>> views, array_view<T> destination)
+	{
+		return merge_sorted(std::move(comparer), views, destination, system_allocator());
+	}
+
+	/// Streaming k-way merging with \a allocator
+	///
+	/// A bounded sequence will be returned which yields the values of the sorted \a views in order
+	/// defined by \a comparer. The views must outlive the sequence.
+	template <typename T, Callable<bool, const T&, const T&> C, Allocator A>
+	bounded_merger<T, C, A> merge_sorted (C comparer, array_view<const array_view<const T>> views, A allocator)
+	{
+		return bounded_merger<T, C, A>(views, std::move(comparer), std::move(allocator));
+	}
+
+	/// Streaming k-way merging
+	///
+	/// The loser tree is allocated from the system allocator. See streaming merge_sorted with
+	/// allocator.
+	template <typename T, Callable<bool, const T&, const T&> C>
+	bounded_merger<T, C> merge_sorted (C comparer, array_view<const array_view<const T>> views)
+	{
+		return bounded_merger<T, C>(views, std::move(comparer), system_allocator());
+	}
+
+}
+
+#endif
@@ -0,0 +1,127 @@
+/// @file parallel_fold.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_PARALLEL_FOLD_HPP__
+#define __STDEXT_PARALLEL_FOLD_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/sequence.hpp>
+#include <stdext/thread_pool.hpp>
+#include <cstddef>
+#include <exception>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace stdext
+{
+
+	/// Amount of elements which are folded sequentially into one partial result by default
+	constexpr std::size_t parallelFoldGrain = 65536;
+
+
+	/// Parallel folding of an indexed bounded sequence on \a pool
+	///
+	/// The \a sequence is split into consecutive chunks of \a grain elements, only the last chunk
+	/// may be shorter. Each chunk is folded by \a combiner over a copy of \a identity as a job of
+	/// \a pool. The partial results are merged by \a merger in order of their chunks from left to
+	/// right. The chunks depend on the length and \a grain only, not on the amount of threads or
+	/// the order of execution, so the result is reproducible, e.g. for floating point values. If
+	/// \a combiner throws an exception, all chunks are awaited and the exception of the first
+	/// failed chunk will be thrown.
+	///
+	/// @param combiner  A callable object which folds an element into a value and is called
+	///                  concurrently
+	/// @param identity  Value over which each chunk is folded, which must not change the result
+	///                  when merged, like zero for summing
+	/// @param merger    A callable object which merges two partial results, and which must be
+	///                  associative together with \a combiner
+	/// @param sequence  Indexed sequence whose elements are folded
+	/// @param pool      Pool of threads on which the chunks are folded
+	/// @param grain     Amount of elements of each chunk
+	///
+	/// @note Time complexity is n/p + n/g with n being the length of the sequence, p being the
+	///       amount of threads and g being the grain.
+	///
+	template <typename V, IndexedBoundedSequence S, Callable<V, V, sequence_type_t<S>> C, Callable<V, V, V> M>
+	V fold_parallel (C combiner, V identity, M merger, S sequence, thread_pool & pool, std::size_t grain = parallelFoldGrain)
+	{
+		const auto length = sequence.length();
+		if (grain == 0)
+			grain = 1;
+		if (length <= grain)
+			return sequence.fold(std::move(combiner), std::move(identity));
+
+		const auto count = (length + grain - 1) / grain;
+		auto results = std::vector<V>(count, identity);
+		auto exceptions = std::vector<std::exception_ptr>(count);
+		auto rest = std::move(sequence);
+		try
+		{
+			for (std::size_t index = 0; index < count; ++index)
+			{
+				auto splitting = rest.split(grain);
+				pool.submit([chunk = std::move(std::get<0>(splitting)), &result = results[index], &exception = exceptions[index], &combiner]()
+				{
+					try
+					{
+						result = chunk.fold(combiner, std::move(result));
+					}
+					catch (...)
+					{
+						exception = std::current_exception();
+					}
+				});
+				rest = std::move(std::get<1>(splitting));
+			}
+		}
+		catch (...)
+		{
+			// the submitted jobs refer to the results and the combiner
+			pool.wait();
+			throw;
+		}
+		pool.wait();
+
+		for (const auto & exception : exceptions)
+		{
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+
+		auto value = std::move(results[0]);
+		for (std::size_t index = 1; index < count; ++index)
+			value = merger(std::move(value), std::move(results[index]));
+		return value;
+	}
+
+	/// Parallel folding of an indexed bounded sequence on \a threadCount threads
+	///
+	/// A pool of \a threadCount threads including the calling one is created for folding. Even a
+	/// single thread folds the same chunks in the same order, so the result does not depend on \a
+	/// threadCount. See fold_parallel with pool.
+	template <typename V, IndexedBoundedSequence S, Callable<V, V, sequence_type_t<S>> C, Callable<V, V, V> M>
+	V fold_parallel (C combiner, V identity, M merger, S sequence, std::size_t threadCount, std::size_t grain = parallelFoldGrain)
+	{
+		if (sequence.length() <= grain)
+			return sequence.fold(std::move(combiner), std::move(identity));
+
+		auto pool = thread_pool(threadCount);
+		return fold_parallel(std::move(combiner), std::move(identity), std::move(merger), std::move(sequence), pool, grain);
+	}
+
+	/// Parallel reduction of an indexed bounded sequence on \a pool
+	///
+	/// All elements are merged by \a merger, which serves as combiner as well. The chunks and
+	/// the order of merging are the same as with fold_parallel.
+	template <typename V, IndexedBoundedSequence S, Callable<V, V, V> M>
+		requires Callable<M, V, V, sequence_type_t<S>>
+	V reduce_parallel (M merger, V identity, S sequence, thread_pool & pool, std::size_t grain = parallelFoldGrain)
+	{
+		return fold_parallel(merger, std::move(identity), merger, std::move(sequence), pool, grain);
+	}
+
+}
+
+#endif
@@ -0,0 +1,460 @@
+/// @file pipeline.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_PIPELINE_HPP__
+#define __STDEXT_PIPELINE_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/array.hpp>
+#include <stdext/array_view.hpp>
+#include <stdext/optional.hpp>
+#include <stdext/sequence.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace stdext
+{
+
+	/// Exception for invalid pipeline traversals
+	///
+	/// It is thrown when a copy of a pipelined sequence is used after the batch at its position
+	/// has been handed back to the upstream stage.
+	class pipeline_error
+	{
+
+		private:
+
+			const char * reason;
+
+		public:
+
+			constexpr explicit pipeline_error (const char * reason) noexcept
+				: reason(reason)
+			{}
+
+			constexpr const char * what () const
+			{
+				return reason;
+			}
+	};
+
+
+	/// Bounded queue between a single producer and a single consumer
+	///
+	/// The values are kept in a ring of fixed capacity which is allocated once. The producer only
+	/// writes the tail index and the consumer only writes the head index, so pushing and popping
+	/// need no lock as long as the queue is neither full nor empty. Only a thread which has to
+	/// wait takes the mutex, and the other thread notifies it only if it waits. After closing,
+	/// pushing fails and popping fails as soon as the queue is empty.
+	template <typename T>
+	class spsc_queue
+	{
+
+	private:
+
+		struct slot
+		{
+			alignas(T) unsigned char bytes[sizeof(T)];
+		};
+
+		std::unique_ptr<slot[]> slots;
+		std::size_t capacity;
+		alignas(64) std::atomic<std::size_t> head{0};
+		alignas(64) std::atomic<std::size_t> tail{0};
+		std::atomic<bool> closed{false};
+		std::atomic<bool> producerWaiting{false};
+		std::atomic<bool> consumerWaiting{false};
+		std::mutex mutex;
+		std::condition_variable notFull;
+		std::condition_variable notEmpty;
+
+
+		T * at (std::size_t index)
+		{
+			return std::launder(reinterpret_cast<T *>(slots[index % capacity].bytes));
+		}
+
+		/// Wakes up the other thread, if it waits on \a condition as flagged by \a waiting
+		void wake (std::atomic<bool> & waiting, std::condition_variable & condition)
+		{
+			if (waiting.load())
+			{
+				auto lock = std::unique_lock<std::mutex>(mutex);
+				condition.notify_one();
+			}
+		}
+
+		/// Waits on \a condition until \a predicate holds, flagged by \a waiting
+		template <Callable<bool> P>
+		void sleep (std::atomic<bool> & waiting, std::condition_variable & condition, P predicate)
+		{
+			auto lock = std::unique_lock<std::mutex>(mutex);
+			waiting.store(true);
+			condition.wait(lock, predicate);
+			waiting.store(false);
+		}
+
+	public:
+
+		/// Constructor with the maximal amount of queued values \a capacity
+		explicit spsc_queue (std::size_t capacity)
+			: slots(new slot[capacity > 0 ? capacity : 1]), capacity(capacity > 0 ? capacity : 1)
+		{}
+
+		spsc_queue (const spsc_queue &) = delete;
+		spsc_queue& operator = (const spsc_queue &) = delete;
+
+		/// Destructor
+		///
+		/// All values which have not been popped are destructed.
+		~spsc_queue ()
+		{
+			for (auto index = head.load(); index != tail.load(); ++index)
+				at(index)->~T();
+		}
+
+		/// Pushes \a value, waiting while the queue is full
+		///
+		/// False will be returned, if the queue has been closed. Only the producer may push.
+		bool push (T value)
+		{
+			const auto end = tail.load(std::memory_order_relaxed);
+			if (end - head.load(std::memory_order_acquire) == capacity)
+			{
+				sleep(producerWaiting, notFull, [this, end]()
+				{
+					return end - head.load() < capacity or closed.load();
+				});
+			}
+			if (closed.load())
+				return false;
+
+			new (at(end)) T(std::move(value));
+			tail.store(end + 1);
+			wake(consumerWaiting, notEmpty);
+			return true;
+		}
+
+		/// Pushes \a value, unless the queue is full or closed
+		///
+		/// A boolean is returned indicating whether \a value has been pushed.
+		bool try_push (T & value)
+		{
+			const auto end = tail.load(std::memory_order_relaxed);
+			if (closed.load() or end - head.load(std::memory_order_acquire) == capacity)
+				return false;
+
+			new (at(end)) T(std::move(value));
+			tail.store(end + 1);
+			wake(consumerWaiting, notEmpty);
+			return true;
+		}
+
+		/// Pops the next value into \a value, waiting while the queue is empty
+		///
+		/// False will be returned, if the queue is empty and has been closed. Only the consumer
+		/// may pop.
+		bool pop (T & value)
+		{
+			const auto begin = head.load(std::memory_order_relaxed);
+			if (begin == tail.load(std::memory_order_acquire))
+			{
+				sleep(consumerWaiting, notEmpty, [this, begin]()
+				{
+					return begin != tail.load() or closed.load();
+				});
+				if (begin == tail.load())
+					return false;
+			}
+
+			auto * next = at(begin);
+			value = std::move(*next);
+			next->~T();
+			head.store(begin + 1);
+			wake(producerWaiting, notFull);
+			return true;
+		}
+
+		/// Pops the next value into \a value, unless the queue is empty
+		///
+		/// A boolean is returned indicating whether a value has been popped.
+		bool try_pop (T & value)
+		{
+			const auto begin = head.load(std::memory_order_relaxed);
+			if (begin == tail.load(std::memory_order_acquire))
+				return false;
+
+			auto * next = at(begin);
+			value = std::move(*next);
+			next->~T();
+			head.store(begin + 1);
+			wake(producerWaiting, notFull);
+			return true;
+		}
+
+		/// Closes the queue and wakes up both threads
+		void close ()
+		{
+			{
+				auto lock = std::unique_lock<std::mutex>(mutex);
+				closed.store(true);
+			}
+			notFull.notify_all();
+			notEmpty.notify_all();
+		}
+	};
+
+
+	/// Amount of elements which the upstream stage of a pipeline pushes at once by default
+	constexpr std::size_t pipelineBatchLength = 1024;
+
+	/// Amount of batches which may wait between two stages of a pipeline by default
+	constexpr std::size_t pipelineQueueLength = 8;
+
+
+	/// Bounded sequence of elements produced by an upstream stage on its own thread
+	///
+	/// The upstream sequence is folded on a separate thread, which pushes its elements in batches
+	/// through a bounded queue. The downstream stage traverses the batches like any bounded
+	/// sequence, so both stages run in parallel. The queue holds at most \a queueLength batches,
+	/// so a fast upstream stage waits for the downstream one instead of buffering everything.
+	/// Consumed batches are handed back to the upstream thread and reused. All copies of the
+	/// sequence share the queue, so traversal is single-pass: once the next batch has been
+	/// popped, copies positioned before it cannot be used anymore, and using them throws \a
+	/// pipeline_error instead of reading a batch the upstream thread refills. An exception thrown by the
+	/// upstream stage is thrown again by the downstream traversal reaching its end. If the last
+	/// copy is destructed early, the upstream thread is stopped at its next batch and joined.
+	template <typename T>
+	class pipelined_sequence
+	{
+
+	private:
+
+		struct channel
+		{
+			spsc_queue<array<T>> batches;
+			spsc_queue<array<T>> returns;
+			std::exception_ptr exception;
+			std::thread producer;
+			array<T> current;
+			std::size_t begin = 0;
+			bool ended = false;
+
+			explicit channel (std::size_t queueLength)
+				: batches(queueLength), returns(queueLength + 2), current(system_allocator())
+			{}
+
+			channel (const channel &) = delete;
+			channel& operator = (const channel &) = delete;
+
+			~channel ()
+			{
+				batches.close();
+				returns.close();
+				if (producer.joinable())
+					producer.join();
+			}
+
+			/// Returns an empty batch, reused from the consumer if possible
+			array<T> take_batch ()
+			{
+				auto batch = array<T>(system_allocator());
+				if (returns.try_pop(batch))
+					batch.erase(0, batch.length());
+				return batch;
+			}
+
+			/// Folds \a sequence into batches of \a batchLength elements and pushes them
+			template <BoundedSequence S>
+			void produce (const S & sequence, std::size_t batchLength)
+			{
+				try
+				{
+					auto batch = take_batch();
+					batch.reserve(batchLength);
+					auto keepOn = true;
+					sequence.fold([this, &batch, &keepOn, batchLength](std::size_t count, auto && element)
+					{
+						batch.append(std::forward<decltype(element)>(element));
+						if (batch.length() == batchLength)
+						{
+							keepOn = batches.push(std::move(batch));
+							batch = take_batch();
+							batch.reserve(batchLength);
+						}
+						return std::make_tuple(count + 1, keepOn);
+					}, std::size_t(0));
+					if (keepOn and not batch.empty())
+						batches.push(std::move(batch));
+				}
+				catch (...)
+				{
+					exception = std::current_exception();
+				}
+				batches.close();
+			}
+
+			/// Pops batches until the element at \a offset is available and returns whether it
+			/// exists
+			bool reach (std::size_t offset)
+			{
+				if (offset < begin)
+					throw pipeline_error("elements have been handed back to the upstream stage");
+				while (offset >= begin + current.length() and not ended)
+				{
+					begin += current.length();
+					auto next = array<T>(system_allocator());
+					if (batches.pop(next))
+					{
+						std::swap(current, next);
+						returns.try_push(next);
+					}
+					else
+					{
+						current.erase(0, current.length());
+						ended = true;
+						if (exception)
+							std::rethrow_exception(exception);
+					}
+				}
+				return offset < begin + current.length();
+			}
+		};
+
+		std::shared_ptr<channel> source;
+		std::size_t position = 0;
+		std::size_t end = std::size_t(-1);
+
+		pipelined_sequence (std::shared_ptr<channel> source, std::size_t position, std::size_t end)
+			: source(std::move(source)), position(position), end(end)
+		{}
+
+		/// Pops batches until the element at \a offset is available and returns whether it exists
+		/// before the end
+		bool reach (std::size_t offset) const
+		{
+			return offset < end and source->reach(offset);
+		}
+
+		/// Returns the end of the current batch, limited by the end of the sequence
+		std::size_t batch_end () const
+		{
+			const auto last = source->begin + source->current.length();
+			return last < end ? last : end;
+		}
+
+	public:
+
+		using value_type = T;
+
+		/// Starts folding \a sequence on a new thread
+		///
+		/// The elements are pushed in batches of \a batchLength elements through a queue of \a
+		/// queueLength batches.
+		template <BoundedSequence S>
+		explicit pipelined_sequence (S sequence, std::size_t batchLength = pipelineBatchLength, std::size_t queueLength = pipelineQueueLength)
+			: source(std::make_shared<channel>(queueLength))
+		{
+			auto * target = source.get();
+			const auto length = batchLength > 0 ? batchLength : 1;
+			source->producer = std::thread([target, sequence = std::move(sequence), length]()
+			{
+				target->produce(sequence, length);
+			});
+		}
+
+		bool empty () const
+		{
+			return not reach(position);
+		}
+
+		optional<std::tuple<T, pipelined_sequence>> decompose () const
+		{
+			using U = optional<std::tuple<T, pipelined_sequence>>;
+			if (not reach(position))
+				return U();
+			const auto & element = source->current.data()[position - source->begin];
+			return U(std::make_tuple(element, pipelined_sequence(source, position + 1, end)));
+		}
+
+		/// Complete folding
+		///
+		/// All remaining elements are consecutively folded over \a value by \a combiner. Each
+		/// batch is traversed in a tight loop.
+		template <typename V, Callable<V, V, const T&> C>
+		V fold (C combiner, V value) const
+		{
+			auto offset = position;
+			while (reach(offset))
+			{
+				const auto * values = source->current.data();
+				const auto skipped = source->begin;
+				const auto last = batch_end();
+				for (; offset < last; ++offset)
+					value = combiner(std::move(value), values[offset - skipped]);
+			}
+			return value;
+		}
+
+		/// Partial folding
+		///
+		/// The remaining elements are consecutively folded over \a value by \a combiner until it
+		/// returns a false flag. The folded value will be returned along with the sequences of the
+		/// passed elements and of the elements which have not been passed. The passed elements can
+		/// only be traversed again as long as they belong to the current batch.
+		template <typename V, Callable<std::tuple<V, bool>, V, const T&> C>
+		std::tuple<V, pipelined_sequence, pipelined_sequence> fold (C combiner, V value) const
+		{
+			auto offset = position;
+			auto keepOn = true;
+			while (keepOn and reach(offset))
+			{
+				std::tie(value, keepOn) = combiner(std::move(value), source->current.data()[offset - source->begin]);
+				if (keepOn) ++offset;
+			}
+			return std::make_tuple(std::move(value), pipelined_sequence(source, position, offset), pipelined_sequence(source, offset, end));
+		}
+
+		/// Chunked folding
+		///
+		/// Each batch of remaining elements is folded over \a value by \a combiner as a view. See
+		/// the concept ChunkedSequence.
+		template <typename V, Callable<V, V, array_view<const T>> C>
+		V fold_chunks (C combiner, V value) const
+		{
+			auto offset = position;
+			while (reach(offset))
+			{
+				const auto skipped = offset - source->begin;
+				const auto last = batch_end();
+				value = combiner(std::move(value), array_view<const T>(source->current.data() + skipped, last - offset));
+				offset = last;
+			}
+			return value;
+		}
+	};
+
+	/// Puts a stage boundary behind \a sequence
+	///
+	/// The bounded \a sequence, usually a chain of sequencers, is folded on its own thread. The
+	/// returned sequence yields its elements to the downstream stage in the calling thread. See
+	/// pipelined_sequence.
+	template <BoundedSequence S>
+	pipelined_sequence<std::decay_t<sequence_type_t<S>>> pipeline (S sequence, std::size_t batchLength = pipelineBatchLength, std::size_t queueLength = pipelineQueueLength)
+	{
+		return pipelined_sequence<std::decay_t<sequence_type_t<S>>>(std::move(sequence), batchLength, queueLength);
+	}
+
+}
+
+#endif
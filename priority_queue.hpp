@@ -0,0 +1,377 @@
+/// @file priority_queue.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_PRIORITY_QUEUE_HPP__
+#define __STDEXT_PRIORITY_QUEUE_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/allocator.hpp>
+#include <stdext/array.hpp>
+#include <stdext/array_view.hpp>
+#include <stdext/optional.hpp>
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace stdext
+{
+
+	/// Priority queue as implicit d-ary heap
+	///
+	/// The queue holds values of type \a T in a heap with \a Arity children per node, which is
+	/// laid out in an array. The value which comes first in order of \a C is on top, e.g. the least
+	/// value if \a C is a less-than comparer. All children of a node are placed next to each other,
+	/// so a heap with four children per node needs half as many levels as a binary heap and scans
+	/// the children of a node within a single cache line. Each pushed value is tracked by a handle,
+	/// with which it can be accessed, moved up or erased later. Memory is allocated from \a A.
+	template <typename T, Callable<bool, const T&, const T&> C, Allocator A = system_allocator, std::size_t Arity = 4>
+	class priority_queue
+	{
+
+		static_assert(Arity >= 2, "Priority queue must have at least two children per node!");
+		static_assert(not std::is_const<T>::value, "Value of priority_queue must not be constant!");
+
+	public:
+
+		/// Handle of a value in the queue
+		///
+		/// The handle stays valid until its value is popped or erased. Afterwards it may be reused
+		/// for another value.
+		struct handle
+		{
+			std::size_t id = 0;
+		};
+
+	private:
+
+		static constexpr std::size_t noPosition = std::size_t(-1);
+
+		struct entry
+		{
+			T value;
+			std::size_t id;
+
+			template <typename ... As>
+			entry (std::size_t id, As && ... arguments)
+				: value(std::forward<As>(arguments) ...), id(id)
+			{}
+		};
+
+		C comparer;
+		array<entry, A> entries;
+
+		/// Position of each handle in the heap, or the next free handle for free handles
+		array<std::size_t, A> positions;
+		std::size_t freeHandle = noPosition;
+
+
+		/// Returns a free handle, which may have been used before
+		std::size_t acquire_handle ()
+		{
+			if (freeHandle != noPosition)
+			{
+				const auto id = freeHandle;
+				freeHandle = positions.view().data()[id];
+				return id;
+			}
+			positions.append(noPosition);
+			return positions.length() - 1;
+		}
+
+		/// Puts handle \a id into the list of free handles
+		void release_handle (std::size_t id)
+		{
+			positions.view().data()[id] = freeHandle;
+			freeHandle = id;
+		}
+
+		/// Moves the entry at \a position up until its parent comes before it
+		///
+		/// The entry is held aside while the parents are moved down, so each level costs one move
+		/// instead of a swap. The final position will be returned.
+		std::size_t sift_up (std::size_t position)
+		{
+			entry * values = entries.view().data();
+			std::size_t * places = positions.view().data();
+
+			if (position == 0 or not comparer(values[position].value, values[(position - 1) / Arity].value))
+				return position;
+
+			auto moving = std::move(values[position]);
+			do
+			{
+				const auto parent = (position - 1) / Arity;
+				values[position] = std::move(values[parent]);
+				places[values[position].id] = position;
+				position = parent;
+			}
+			while (position > 0 and comparer(moving.value, values[(position - 1) / Arity].value));
+
+			values[position] = std::move(moving);
+			places[values[position].id] = position;
+			return position;
+		}
+
+		/// Moves the entry at \a position down until it comes before all of its children
+		///
+		/// Only the first \a end entries are considered to be part of the heap.
+		void sift_down (std::size_t position, std::size_t end)
+		{
+			entry * values = entries.view().data();
+			std::size_t * places = positions.view().data();
+
+			auto moving = std::move(values[position]);
+			while (true)
+			{
+				const auto first = position * Arity + 1;
+				if (first >= end)
+					break;
+
+				const auto last = first + Arity < end ? first + Arity : end;
+				auto best = first;
+				for (auto child = first + 1; child < last; ++child)
+				{
+					if (comparer(values[child].value, values[best].value))
+						best = child;
+				}
+				if (not comparer(values[best].value, moving.value))
+					break;
+
+				values[position] = std::move(values[best]);
+				places[values[position].id] = position;
+				position = best;
+			}
+
+			values[position] = std::move(moving);
+			places[values[position].id] = position;
+		}
+
+		/// Restores the heap order of all entries bottom-up in linear time
+		void heapify ()
+		{
+			const auto end = entries.length();
+			if (end < 2)
+				return;
+
+			for (auto parent = (end - 2) / Arity + 1; parent > 0; --parent)
+				sift_down(parent - 1, end);
+		}
+
+		/// Removes the entry at \a position and returns its value
+		T remove (std::size_t position)
+		{
+			entry * values = entries.view().data();
+			const auto last = entries.length() - 1;
+
+			auto removed = std::move(values[position].value);
+			release_handle(values[position].id);
+			if (position != last)
+			{
+				values[position] = std::move(values[last]);
+				positions.view().data()[values[position].id] = position;
+			}
+			entries.erase(last);
+
+			if (position < last and sift_up(position) == position)
+				sift_down(position, last);
+			return removed;
+		}
+
+	public:
+
+		/// Construction with \a comparer and \a allocator
+		///
+		/// No memory will be allocated until the first value is pushed.
+		priority_queue (C comparer, A allocator)
+			: comparer(std::move(comparer)), entries(allocator), positions(allocator)
+		{}
+
+		/// Construction with \a comparer
+		///
+		/// The allocator will be default constructed.
+		explicit priority_queue (C comparer)
+			: priority_queue(std::move(comparer), A())
+		{}
+
+		/// Returns the amount of values in the queue
+		std::size_t length () const
+		{
+			return entries.length();
+		}
+
+		/// Returns whether the queue contains no value
+		bool empty () const
+		{
+			return entries.empty();
+		}
+
+		/// Returns the value on top of the queue
+		///
+		/// If the queue is empty, an empty optional container will be returned.
+		optional<const T&> top () const
+		{
+			if (entries.empty())
+				return optional<const T&>();
+			return optional<const T&>(&entries.data()[0].value);
+		}
+
+		/// Returns the value of handle \a h
+		///
+		/// The handle must be valid.
+		const T & value (handle h) const
+		{
+			return entries.data()[positions.data()[h.id]].value;
+		}
+
+		/// Reserves memory for at least \a count values without reallocation
+		///
+		/// If not enough memory could be allocated, the exception \a bad_alloc will be thrown and
+		/// the queue remains unchanged.
+		void reserve (std::size_t count)
+		{
+			entries.reserve(count);
+			positions.reserve(count);
+		}
+
+		/// Pushing a value
+		///
+		/// A value is constructed with \a arguments and moved up to its place. The handle of the
+		/// value will be returned. If any exception is thrown, the queue remains unchanged.
+		///
+		/// @note Time complexity is logarithmic to the base of \a Arity in the length of the queue.
+		///
+		template <typename ... As>
+			requires std::is_constructible<T, As ...>::value
+		handle push (As && ... arguments)
+		{
+			const auto id = acquire_handle();
+			try
+			{
+				entries.append(id, std::forward<As>(arguments) ...);
+			}
+			catch (...)
+			{
+				release_handle(id);
+				throw;
+			}
+			positions.view().data()[id] = entries.length() - 1;
+			sift_up(entries.length() - 1);
+			return handle{id};
+		}
+
+		/// Pushing many values
+		///
+		/// All \a values are copied into the queue. If at least as many values are pushed as are
+		/// already contained, the heap is rebuilt bottom-up in linear time, otherwise each value is
+		/// moved up on its own. The handles of the values are not returned. If any exception is
+		/// thrown, the values pushed before remain in the queue.
+		///
+		/// @note Time complexity is linear in the resulting length, or n*log(m) with n being the
+		///       amount of pushed values and m being the resulting length, whichever is less.
+		///
+		void push_many (array_view<const T> values)
+		{
+			const auto count = values.length();
+			const auto bulk = count >= entries.length();
+			reserve(entries.length() + count);
+
+			for (std::size_t index = 0; index < count; ++index)
+			{
+				const auto id = acquire_handle();
+				try
+				{
+					entries.append(id, values.data()[index]);
+				}
+				catch (...)
+				{
+					release_handle(id);
+					if (bulk)
+						heapify();
+					throw;
+				}
+				positions.view().data()[id] = entries.length() - 1;
+				if (not bulk)
+					sift_up(entries.length() - 1);
+			}
+
+			if (bulk)
+				heapify();
+		}
+
+		/// Popping the value on top
+		///
+		/// The value on top will be removed from the queue and returned. Its handle becomes
+		/// invalid. If the queue is empty, an empty optional container will be returned.
+		///
+		/// @note Time complexity is logarithmic to the base of \a Arity in the length of the queue,
+		///       times \a Arity comparisons per level.
+		///
+		optional<T> pop ()
+		{
+			if (entries.empty())
+				return optional<T>();
+			return optional<T>(remove(0));
+		}
+
+		/// Popping many values into \a destination
+		///
+		/// The values on top will be popped in order and moved to \a destination until it is full
+		/// or the queue is empty. The part of \a destination holding the popped values and the
+		/// remaining part will be returned.
+		std::tuple<array_view<T>, array_view<T>> pop_many (array_view<T> destination)
+		{
+			T * values = destination.data();
+			auto index = std::size_t(0);
+			while (index < destination.length() and not entries.empty())
+			{
+				values[index] = remove(0);
+				++index;
+			}
+			return std::make_tuple(array_view<T>(values, index), array_view<T>(values + index, destination.length() - index));
+		}
+
+		/// Erasing the value of handle \a h
+		///
+		/// The value will be removed from the queue and returned. The handle must be valid and
+		/// becomes invalid.
+		T erase (handle h)
+		{
+			return remove(positions.view().data()[h.id]);
+		}
+
+		/// Decreasing the key of handle \a h
+		///
+		/// The value of the handle will be assigned to \a value, which must not come after the
+		/// current value in order of the comparer, and moved up to its place. The handle must be
+		/// valid.
+		///
+		/// @note Time complexity is logarithmic to the base of \a Arity in the length of the queue.
+		///
+		void decrease (handle h, T value)
+		{
+			const auto position = positions.view().data()[h.id];
+			entry & current = entries.view().data()[position];
+			assert(not comparer(current.value, value));
+			current.value = std::move(value);
+			sift_up(position);
+		}
+
+		/// Updating the key of handle \a h
+		///
+		/// The value of the handle will be assigned to \a value and moved up or down to its place.
+		/// The handle must be valid.
+		void update (handle h, T value)
+		{
+			const auto position = positions.view().data()[h.id];
+			entries.view().data()[position].value = std::move(value);
+			if (sift_up(position) == position)
+				sift_down(position, entries.length());
+		}
+
+	};
+
+}
+
+#endif
@@ -5,13 +5,19 @@
 #ifndef __STDEXT_SEQUENCE_CONCEPT_HPP__
 #define __STDEXT_SEQUENCE_CONCEPT_HPP__
 
+#include <array>
+#include <cassert>
+#include <cstddef>
 #include <tuple>
+#include <type_traits>
 #include <stdext/optional.hpp>
 #include <stdext/callable.hpp>
 
 namespace stdext
 {
 
+	template <typename T> class array_view;
+
 	/// Concept of a bounded sequence
 	///
 	/// A bounded sequence is a definition of finite many values which are ordered. The definition
@@ -85,6 +91,70 @@ namespace stdext
 
 
 
+	/// Concept of an indexed bounded sequence
+	///
+	/// An indexed bounded sequence is a bounded sequence whose elements are directly accessible.
+	/// The method at returns the element at an index, which must be less than the length. The
+	/// method length returns the amount of elements, and the method split returns the sequences of
+	/// the elements before and from an index. All of them take constant time.
+	template <typename S> concept bool IndexedBoundedSequence ()
+	{
+		return BoundedSequence<S> and
+		       requires (S s, std::size_t index)
+		       {
+		         s.at(index);
+		         {s.length()} -> std::size_t;
+		         {s.split(index)} -> std::tuple<S, S>;
+		       };
+	}
+
+	/// Concept of an indexed unbounded sequence
+	///
+	/// An indexed unbounded sequence is an unbounded sequence whose elements are directly
+	/// accessible. The method at returns the element at an index, and the method drop returns the
+	/// sequence of the elements from an index. Both of them take constant time.
+	template <typename S> concept bool IndexedUnboundedSequence ()
+	{
+		return UnboundedSequence<S> and
+		       requires (S s, std::size_t index)
+		       {
+		         s.at(index);
+		         {s.drop(index)} -> S;
+		       };
+	}
+
+
+
+	/// Maximal amount of elements which sequencers buffer for one chunk
+	constexpr std::size_t sequenceChunkLength = 256;
+
+	/// Combiner accepting any chunk, with which chunked sequences are detected
+	struct chunk_probe
+	{
+		template <typename C>
+		constexpr int operator () (int value, C) const
+		{
+			return value;
+		}
+	};
+
+	/// Concept of a chunked sequence
+	///
+	/// A chunked sequence is a bounded sequence whose elements are laid out in contiguous memory,
+	/// at least in parts. Additionally to folding element by element, it implements the method
+	/// fold_chunks, which folds array views of consecutive elements over a value. Sequencers can
+	/// process whole chunks in tight loops, which the compiler is able to vectorize.
+	template <typename S> concept bool ChunkedSequence ()
+	{
+		return BoundedSequence<S> and
+		       requires (S s)
+		       {
+		         s.fold_chunks(chunk_probe(), int(0));
+		       };
+	}
+
+
+
 	/// Trait of sequence's element type
 	template <typename S> struct sequence_type {};
 	template <BoundedSequence S> struct sequence_type<S>
@@ -278,6 +348,134 @@ namespace stdext
 
 
 
+	/// Bounded sequence of consecutive values
+	///
+	/// The sequence yields \a count values beginning at \a first, each one incremented from its
+	/// predecessor. Its elements are computed from their index, so it models an indexed bounded
+	/// sequence.
+	template <typename T>
+	class bounded_iota
+	{
+
+	private:
+
+		T first;
+		std::size_t count;
+
+	public:
+
+		using value_type = T;
+
+		constexpr bounded_iota (T first, std::size_t count)
+			noexcept(std::is_nothrow_move_constructible<T>::value)
+			: first(std::move(first)), count(count)
+		{}
+
+		constexpr bool empty () const
+		{
+			return count == 0;
+		}
+
+		constexpr std::size_t length () const
+		{
+			return count;
+		}
+
+		constexpr T at (std::size_t index) const
+		{
+			assert(index < count);
+			return first + static_cast<T>(index);
+		}
+
+		constexpr std::tuple<bounded_iota, bounded_iota> split (std::size_t index) const
+		{
+			const auto cut = index < count ? index : count;
+			return std::make_tuple(bounded_iota(first, cut), bounded_iota(first + static_cast<T>(cut), count - cut));
+		}
+
+		constexpr optional<std::tuple<T, bounded_iota>> decompose () const
+		{
+			using U = optional<std::tuple<T, bounded_iota>>;
+			return count == 0 ? U() : U(std::make_tuple(first, bounded_iota(first + 1, count - 1)));
+		}
+
+		template <typename V, Callable<V, V, T> C>
+		constexpr V fold (C combiner, V value) const
+		{
+			auto next = first;
+			for (std::size_t index = 0; index < count; ++index, ++next)
+				value = combiner(std::move(value), next);
+			return value;
+		}
+
+		template <typename V, Callable<std::tuple<V, bool>, V, T> C>
+		constexpr std::tuple<V, bounded_iota, bounded_iota> fold (C combiner, V value) const
+		{
+			auto index = std::size_t(0);
+			auto keepOn = true;
+			while (index < count and keepOn)
+			{
+				std::tie(value, keepOn) = combiner(std::move(value), first + static_cast<T>(index));
+				if (keepOn) ++index;
+			}
+			return std::tuple_cat(std::make_tuple(std::move(value)), split(index));
+		}
+
+	};
+
+	/// Unbounded sequence of consecutive values
+	///
+	/// The sequence yields the values from \a first on, each one incremented from its
+	/// predecessor. It models an indexed unbounded sequence.
+	template <typename T>
+	class unbounded_iota
+	{
+
+	private:
+
+		T first;
+
+	public:
+
+		using value_type = T;
+
+		explicit constexpr unbounded_iota (T first)
+			noexcept(std::is_nothrow_move_constructible<T>::value)
+			: first(std::move(first))
+		{}
+
+		constexpr T at (std::size_t index) const
+		{
+			return first + static_cast<T>(index);
+		}
+
+		constexpr unbounded_iota drop (std::size_t index) const
+		{
+			return unbounded_iota(first + static_cast<T>(index));
+		}
+
+		constexpr std::tuple<T, unbounded_iota> decompose () const
+		{
+			return std::make_tuple(first, unbounded_iota(first + 1));
+		}
+
+		template <typename V, Callable<std::tuple<V, bool>, V, T> C>
+		constexpr std::tuple<V, unbounded_iota> fold (C combiner, V value) const
+		{
+			auto next = first;
+			auto keepOn = true;
+			while (keepOn)
+			{
+				std::tie(value, keepOn) = combiner(std::move(value), next);
+				if (keepOn) ++next;
+			}
+			return std::make_tuple(std::move(value), unbounded_iota(next));
+		}
+
+	};
+
+
+
 	/// Bounded filter sequencer
 	template <BoundedSequence S, Callable<bool, sequence_type_t<S>> C>
 	class bounded_filter
@@ -334,10 +532,57 @@ namespace stdext
 		template <typename V, Callable<V, V, value_type> D>
 		constexpr V fold (D combiner, V value) const
 		{
-			return sequence.fold([&predictor, &combiner](auto value, auto element)
+			if constexpr (ChunkedSequence<S>)
 			{
-				return predictor(element) ? combiner(std::move(value), std::move(element)) : std::move(value);
+				return sequence.fold_chunks([this, &combiner](V value, auto chunk)
+				{
+					for (std::size_t index = 0; index < chunk.length(); ++index)
+					{
+						if (predictor(chunk.data()[index]))
+							value = combiner(std::move(value), chunk.data()[index]);
+					}
+					return value;
+				}, std::move(value));
+			}
+			else
+			{
+				return sequence.fold([&predictor, &combiner](auto value, auto element)
+				{
+					return predictor(element) ? combiner(std::move(value), std::move(element)) : std::move(value);
+				}, std::move(value));
+			}
+		}
+
+		/// Chunked folding
+		///
+		/// The conforming elements of the chunks of the underlying sequence are gathered in a buffer
+		/// without branching on the predictor. Each time the buffer is full, it is folded over \a
+		/// value by \a combiner as an array view, and so is the partially filled buffer at last.
+		/// Only available if the underlying sequence is chunked.
+		template <typename V, typename D>
+			requires ChunkedSequence<S> and std::is_default_constructible<std::decay_t<value_type>>::value
+		constexpr V fold_chunks (D combiner, V value) const
+		{
+			using U = std::decay_t<value_type>;
+			auto buffer = std::array<U, sequenceChunkLength>();
+			auto count = std::size_t(0);
+			value = sequence.fold_chunks([this, &combiner, &buffer, &count](V value, auto chunk)
+			{
+				for (std::size_t index = 0; index < chunk.length(); ++index)
+				{
+					buffer[count] = chunk.data()[index];
+					count += predictor(buffer[count]) ? 1 : 0;
+					if (count == sequenceChunkLength)
+					{
+						value = combiner(std::move(value), array_view<const U>(buffer.data(), count));
+						count = 0;
+					}
+				}
+				return value;
 			}, std::move(value));
+			if (count > 0)
+				value = combiner(std::move(value), array_view<const U>(buffer.data(), count));
+			return value;
 		}
 
 		template <typename V, Callable<tuple<V, bool>, V, value_type> C>
@@ -479,6 +724,23 @@ namespace stdext
 			return sequence.length();
 		}
 
+		/// Returns the transformed element at \a index of an indexed underlying sequence
+		constexpr value_type at (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			return transformer(sequence.at(index));
+		}
+
+		/// Splits an indexed underlying sequence at \a index into two transformers
+		constexpr std::tuple<bounded_transformer, bounded_transformer> split (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			auto splitting = sequence.split(index);
+			auto pre = bounded_transformer(std::move(std::get<0>(splitting)), transformer);
+			auto post = bounded_transformer(std::move(std::get<1>(splitting)), transformer);
+			return std::make_tuple(std::move(pre), std::move(post));
+		}
+
 		constexpr optional<std::tuple<value_type, bounded_transformer>> decompose () const
 		{
 			return fmap([&transformer](auto decomposition)
@@ -490,9 +752,47 @@ namespace stdext
 		template <typename V, Callable<V, V, value_type> C>
 		constexpr V fold (C combiner, V value) const
 		{
-			return sequence.fold([&transformer, &combiner](auto value, auto element)
+			if constexpr (ChunkedSequence<S>)
 			{
-				return combiner(std::move(value), transformer(std::move(element)));
+				return sequence.fold_chunks([this, &combiner](V value, auto chunk)
+				{
+					for (std::size_t index = 0; index < chunk.length(); ++index)
+						value = combiner(std::move(value), transformer(chunk.data()[index]));
+					return value;
+				}, std::move(value));
+			}
+			else
+			{
+				return sequence.fold([&transformer, &combiner](auto value, auto element)
+				{
+					return combiner(std::move(value), transformer(std::move(element)));
+				}, std::move(value));
+			}
+		}
+
+		/// Chunked folding
+		///
+		/// The chunks of the underlying sequence are transformed into a buffer of at most \a
+		/// sequenceChunkLength elements in a tight loop, and each filled buffer is folded over \a
+		/// value by \a combiner as an array view. Only available if the underlying sequence is
+		/// chunked.
+		template <typename V, typename C>
+			requires ChunkedSequence<S> and std::is_default_constructible<std::decay_t<value_type>>::value
+		constexpr V fold_chunks (C combiner, V value) const
+		{
+			using U = std::decay_t<value_type>;
+			auto buffer = std::array<U, sequenceChunkLength>();
+			return sequence.fold_chunks([this, &combiner, &buffer](V value, auto chunk)
+			{
+				for (std::size_t begin = 0; begin < chunk.length(); begin += sequenceChunkLength)
+				{
+					const auto count = chunk.length() - begin < sequenceChunkLength ? chunk.length() - begin : sequenceChunkLength;
+					const auto * elements = chunk.data() + begin;
+					for (std::size_t index = 0; index < count; ++index)
+						buffer[index] = transformer(elements[index]);
+					value = combiner(std::move(value), array_view<const U>(buffer.data(), count));
+				}
+				return value;
 			}, std::move(value));
 		}
 
@@ -577,6 +877,20 @@ namespace stdext
 			return std::make_tuple(transformer(std::move(std::get<0>(decomposition))), unbounded_transformer(std::move(std::get<1>(decomposition)), transformer));
 		}
 
+		/// Returns the transformed element at \a index of an indexed underlying sequence
+		constexpr value_type at (std::size_t index) const
+			requires IndexedUnboundedSequence<S>
+		{
+			return transformer(sequence.at(index));
+		}
+
+		/// Returns the transformer of the elements from \a index of an indexed underlying sequence
+		constexpr unbounded_transformer drop (std::size_t index) const
+			requires IndexedUnboundedSequence<S>
+		{
+			return unbounded_transformer(sequence.drop(index), transformer);
+		}
+
 		template <typename V, Callable<std::tuple<V, bool>, V, value_type> C>
 		constexpr std::tuple<V, unbounded_transformer> fold (C combiner, V value) const
 		{
@@ -641,6 +955,30 @@ namespace stdext
 			}
 		}
 
+		/// Returns the element at \a index of an indexed underlying sequence
+		///
+		/// The \a index must be less than the length.
+		constexpr value_type at (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			assert(index < length());
+			return sequence.at(index);
+		}
+
+		/// Splits an indexed underlying sequence at \a index
+		///
+		/// Both returned sequencers are truncated, so their lengths are known without looking at
+		/// the underlying sequence.
+		constexpr std::tuple<bounded_ntaker, bounded_ntaker> split (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			const auto count = length();
+			const auto cut = index < count ? index : count;
+			auto splitting = sequence.split(cut);
+			auto post = std::get<0>(std::get<1>(splitting).split(count - cut));
+			return std::make_tuple(bounded_ntaker(std::move(std::get<0>(splitting)), cut, true), bounded_ntaker(std::move(post), count - cut, true));
+		}
+
 		constexpr optional<std::tuple<value_type, bounded_ntaker>> decompose () const
 		{
 			using U = optional<std::tuple<value_type, bounded_ntaker>>;
@@ -654,7 +992,14 @@ namespace stdext
 		template <typename V, Callable<V, V, value_type> C>
 		constexpr V fold (C combiner, V value) const
 		{
-			if (truncated)
+			if constexpr (IndexedBoundedSequence<S>)
+			{
+				const auto count = length();
+				for (std::size_t index = 0; index < count; ++index)
+					value = combiner(std::move(value), sequence.at(index));
+				return value;
+			}
+			else if (truncated)
 			{
 				return sequence.fold(std::move(combiner), std::move(value));
 			}
@@ -789,11 +1134,29 @@ namespace stdext
 			return count == 0;
 		}
 
-		constexpr bool length () const
+		constexpr std::size_t length () const
 		{
 			return count;
 		}
 
+		/// Returns the element at \a index of an indexed underlying sequence
+		///
+		/// The \a index must be less than the length.
+		constexpr value_type at (std::size_t index) const
+			requires IndexedUnboundedSequence<S>
+		{
+			assert(index < count);
+			return sequence.at(index);
+		}
+
+		/// Splits an indexed underlying sequence at \a index
+		constexpr std::tuple<unbounded_ntaker, unbounded_ntaker> split (std::size_t index) const
+			requires IndexedUnboundedSequence<S>
+		{
+			const auto cut = index < count ? index : count;
+			return std::make_tuple(unbounded_ntaker(sequence, cut), unbounded_ntaker(sequence.drop(cut), count - cut));
+		}
+
 		constexpr optional<std::tuple<value_type, unbounded_ntaker>> decompose () const
 		{
 			return make_optional(count > 0, [&]()
@@ -1255,6 +1618,102 @@ namespace stdext
 
 
 
+	/// Count based drop sequencer for bounded sequences
+	///
+	/// The sequencer ignores the first \a count elements of the held sequence. If the held
+	/// sequence is indexed, so is the sequencer, and dropping takes constant time. Otherwise, the
+	/// elements are dropped by decomposition whenever the remaining sequence is needed.
+	template <BoundedSequence S>
+	class bounded_ndropper
+	{
+
+	private:
+
+		S sequence;
+		std::size_t count;
+
+		/// Returns the held sequence without its first \a count elements
+		constexpr S truncate () const
+		{
+			if constexpr (IndexedBoundedSequence<S>)
+			{
+				return std::get<1>(sequence.split(count));
+			}
+			else
+			{
+				auto folding = sequence.fold([limit=count](auto dropped, auto)
+				{
+					const auto isInBound = dropped < limit;
+					return std::make_tuple(dropped + (isInBound ? 1 : 0), isInBound);
+				}, std::size_t(0));
+				return std::get<2>(folding);
+			}
+		}
+
+	public:
+
+		using value_type = sequence_type_t<S>;
+
+		constexpr bounded_ndropper (S sequence, std::size_t count)
+			noexcept(std::is_nothrow_move_constructible<S>::value)
+			: sequence(std::move(sequence)), count(count)
+		{}
+
+		constexpr bool empty () const
+		{
+			return length() == 0;
+		}
+
+		constexpr std::size_t length () const
+		{
+			const auto sequenceLength = sequence.length();
+			return count < sequenceLength ? sequenceLength - count : 0;
+		}
+
+		/// Returns the element at \a index behind the dropped elements of an indexed sequence
+		constexpr value_type at (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			assert(index < length());
+			return sequence.at(count + index);
+		}
+
+		/// Splits the remaining elements of an indexed sequence at \a index
+		constexpr std::tuple<bounded_ndropper, bounded_ndropper> split (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			auto splitting = truncate().split(index);
+			return std::make_tuple(bounded_ndropper(std::move(std::get<0>(splitting)), 0), bounded_ndropper(std::move(std::get<1>(splitting)), 0));
+		}
+
+		constexpr optional<std::tuple<value_type, bounded_ndropper>> decompose () const
+		{
+			return fmap([](auto decomposition)
+			{
+				auto remainings = bounded_ndropper(std::move(std::get<1>(decomposition)), 0);
+				return std::make_tuple(std::move(std::get<0>(decomposition)), std::move(remainings));
+			}, truncate().decompose());
+		}
+
+		template <typename V, Callable<V, V, value_type> C>
+		constexpr V fold (C combiner, V value) const
+		{
+			return truncate().fold(std::move(combiner), std::move(value));
+		}
+
+		template <typename V, Callable<std::tuple<V, bool>, V, value_type> C>
+		constexpr std::tuple<V, bounded_ndropper, bounded_ndropper> fold (C combiner, V value) const
+		{
+			auto folding = truncate().fold(std::move(combiner), std::move(value));
+			auto pre = bounded_ndropper(std::move(std::get<1>(folding)), 0);
+			auto post = bounded_ndropper(std::move(std::get<2>(folding)), 0);
+			return std::make_tuple(std::move(std::get<0>(folding)), std::move(pre), std::move(post));
+		}
+
+	};
+
+
+
 	template <BoundedSequence S, typename T>
 	class bounded_intersperser
 	{
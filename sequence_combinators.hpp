@@ -0,0 +1,1168 @@
+/// @file sequence_combinators.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_SEQUENCE_COMBINATORS_HPP__
+#define __STDEXT_SEQUENCE_COMBINATORS_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/array_view.hpp>
+#include <stdext/optional.hpp>
+#include <stdext/sequence.hpp>
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace stdext
+{
+
+	/// Returns the decomposition of a bounded or unbounded \a sequence as optional container
+	template <Sequence S>
+	constexpr auto decompose_optional (const S & sequence)
+	{
+		if constexpr (BoundedSequence<S>)
+			return sequence.decompose();
+		else
+			return make_optional(sequence.decompose());
+	}
+
+	/// Partially folds \a sequence over its first \a count elements without combining them
+	template <Sequence S>
+	constexpr auto pass_elements (const S & sequence, std::size_t count)
+	{
+		return sequence.fold([count](std::size_t passed, auto &&)
+		{
+			const auto isInBound = passed < count;
+			return std::make_tuple(passed + (isInBound ? 1 : 0), isInBound);
+		}, std::size_t(0));
+	}
+
+	/// Returns \a sequence without its first \a count elements
+	///
+	/// Indexed sequences are split or dropped in constant time, all others are partially folded
+	/// over the elements to be dropped. A bounded sequence with less than \a count elements
+	/// results in an empty sequence.
+	template <Sequence S>
+	constexpr S drop_elements (const S & sequence, std::size_t count)
+	{
+		if constexpr (IndexedBoundedSequence<S>)
+			return std::get<1>(sequence.split(count));
+		else if constexpr (IndexedUnboundedSequence<S>)
+			return sequence.drop(count);
+		else if constexpr (BoundedSequence<S>)
+			return std::get<2>(pass_elements(sequence, count));
+		else
+			return std::get<1>(pass_elements(sequence, count));
+	}
+
+	/// Splits a bounded or an indexed unbounded \a sequence at \a index
+	///
+	/// Indexed sequences are split in constant time, all other bounded ones are partially folded
+	/// over the first \a index elements. An unbounded sequence is not shortened before \a index,
+	/// so the first sequence must be bounded by some other sequence.
+	template <Sequence S>
+		requires BoundedSequence<S> or IndexedUnboundedSequence<S>
+	constexpr std::tuple<S, S> split_elements (const S & sequence, std::size_t index)
+	{
+		if constexpr (IndexedBoundedSequence<S>)
+		{
+			return sequence.split(index);
+		}
+		else if constexpr (BoundedSequence<S>)
+		{
+			auto folding = pass_elements(sequence, index);
+			return std::make_tuple(std::move(std::get<1>(folding)), std::move(std::get<2>(folding)));
+		}
+		else
+		{
+			return std::make_tuple(sequence, sequence.drop(index));
+		}
+	}
+
+	/// Callable object returning the element at \a I of a tuple
+	template <std::size_t I>
+	struct tuple_getter
+	{
+		template <typename T>
+		constexpr auto operator () (const T & tuple) const
+		{
+			return std::get<I>(tuple);
+		}
+	};
+
+
+
+	/// Zip sequencer with at least one bounded sequence
+	///
+	/// The sequencer yields tuples of the elements at the same positions of both held sequences
+	/// and ends with the shorter one. If both sequences are indexed, so is the sequencer, and its
+	/// length and splitting take constant time.
+	template <Sequence S, Sequence R>
+		requires BoundedSequence<S> or BoundedSequence<R>
+	class bounded_zipper
+	{
+
+	private:
+
+		S first;
+		R second;
+
+	public:
+
+		using value_type = std::tuple<sequence_type_t<S>, sequence_type_t<R>>;
+
+		constexpr bounded_zipper (S first, R second)
+			noexcept(std::is_nothrow_move_constructible<S>::value and std::is_nothrow_move_constructible<R>::value)
+			: first(std::move(first)), second(std::move(second))
+		{}
+
+		constexpr bool empty () const
+		{
+			if constexpr (BoundedSequence<S>)
+				if (first.empty()) return true;
+			if constexpr (BoundedSequence<R>)
+				if (second.empty()) return true;
+			return false;
+		}
+
+		constexpr std::size_t length () const
+		{
+			if constexpr (BoundedSequence<S> and BoundedSequence<R>)
+			{
+				const auto firstLength = first.length();
+				const auto secondLength = second.length();
+				return firstLength < secondLength ? firstLength : secondLength;
+			}
+			else if constexpr (BoundedSequence<S>)
+			{
+				return first.length();
+			}
+			else
+			{
+				return second.length();
+			}
+		}
+
+		/// Returns the tuple of elements at \a index of both indexed sequences
+		constexpr value_type at (std::size_t index) const
+			requires (IndexedBoundedSequence<S> or IndexedUnboundedSequence<S>) and
+			         (IndexedBoundedSequence<R> or IndexedUnboundedSequence<R>)
+		{
+			assert(index < length());
+			return value_type(first.at(index), second.at(index));
+		}
+
+		/// Splits both indexed sequences at \a index
+		constexpr std::tuple<bounded_zipper, bounded_zipper> split (std::size_t index) const
+			requires (IndexedBoundedSequence<S> or IndexedUnboundedSequence<S>) and
+			         (IndexedBoundedSequence<R> or IndexedUnboundedSequence<R>)
+		{
+			const auto count = length();
+			const auto cut = index < count ? index : count;
+			auto firsts = split_elements(first, cut);
+			auto seconds = split_elements(second, cut);
+			auto pre = bounded_zipper(std::move(std::get<0>(firsts)), std::move(std::get<0>(seconds)));
+			auto post = bounded_zipper(std::move(std::get<1>(firsts)), std::move(std::get<1>(seconds)));
+			return std::make_tuple(std::move(pre), std::move(post));
+		}
+
+		constexpr optional<std::tuple<value_type, bounded_zipper>> decompose () const
+		{
+			using U = optional<std::tuple<value_type, bounded_zipper>>;
+			return decide([this](auto firsts)
+			{
+				return fmap([&firsts](auto seconds)
+				{
+					auto element = value_type(std::get<0>(firsts), std::get<0>(seconds));
+					auto remainings = bounded_zipper(std::move(std::get<1>(firsts)), std::move(std::get<1>(seconds)));
+					return std::make_tuple(std::move(element), std::move(remainings));
+				}, decompose_optional(second));
+			}, []()
+			{
+				return U();
+			}, decompose_optional(first));
+		}
+
+		/// Complete folding
+		///
+		/// All tuples are consecutively folded over \a value by \a combiner. Indexed sequences are
+		/// traversed by index, otherwise a bounded sequence is folded while the other one is
+		/// decomposed alongside.
+		template <typename V, Callable<V, V, value_type> C>
+		constexpr V fold (C combiner, V value) const
+		{
+			if constexpr ((IndexedBoundedSequence<S> or IndexedUnboundedSequence<S>) and
+			              (IndexedBoundedSequence<R> or IndexedUnboundedSequence<R>))
+			{
+				const auto count = length();
+				for (std::size_t index = 0; index < count; ++index)
+					value = combiner(std::move(value), value_type(first.at(index), second.at(index)));
+				return value;
+			}
+			else
+			{
+				return std::get<0>(fold([&combiner](V value, value_type element)
+				{
+					return std::make_tuple(combiner(std::move(value), std::move(element)), true);
+				}, std::move(value)));
+			}
+		}
+
+		/// Partial folding
+		///
+		/// The tuples are consecutively folded over \a value by \a combiner until it returns a false
+		/// flag or one sequence ends. The folded value will be returned along with the zippers of
+		/// the passed tuples and of the tuples which have not been passed. The first sequence is
+		/// folded if it is bounded, otherwise the second one, and the other one is decomposed
+		/// alongside.
+		template <typename V, Callable<std::tuple<V, bool>, V, value_type> C>
+		constexpr std::tuple<V, bounded_zipper, bounded_zipper> fold (C combiner, V value) const
+		{
+			if constexpr (BoundedSequence<S>)
+			{
+				auto other = second;
+				auto folding = first.fold([&combiner, &other](V value, auto && element)
+				{
+					return decide([&combiner, &other, &element](auto decomposition, V value)
+					{
+						auto combination = combiner(std::move(value), value_type(std::forward<decltype(element)>(element), std::move(std::get<0>(decomposition))));
+						if (std::get<1>(combination))
+							other = std::move(std::get<1>(decomposition));
+						return combination;
+					}, [](V value)
+					{
+						return std::make_tuple(std::move(value), false);
+					}, decompose_optional(other), std::move(value));
+				}, std::move(value));
+				auto passed = bounded_zipper(std::move(std::get<1>(folding)), second);
+				auto rest = bounded_zipper(std::move(std::get<2>(folding)), std::move(other));
+				return std::make_tuple(std::move(std::get<0>(folding)), std::move(passed), std::move(rest));
+			}
+			else
+			{
+				auto other = first;
+				auto folding = second.fold([&combiner, &other](V value, auto && element)
+				{
+					auto decomposition = other.decompose();
+					auto combination = combiner(std::move(value), value_type(std::move(std::get<0>(decomposition)), std::forward<decltype(element)>(element)));
+					if (std::get<1>(combination))
+						other = std::move(std::get<1>(decomposition));
+					return combination;
+				}, std::move(value));
+				auto passed = bounded_zipper(first, std::move(std::get<1>(folding)));
+				auto rest = bounded_zipper(std::move(other), std::move(std::get<2>(folding)));
+				return std::make_tuple(std::move(std::get<0>(folding)), std::move(passed), std::move(rest));
+			}
+		}
+
+	};
+
+	/// Zip sequencer for unbounded sequences
+	///
+	/// The sequencer yields tuples of the elements at the same positions of both held sequences.
+	/// If both sequences are indexed, so is the sequencer.
+	template <UnboundedSequence S, UnboundedSequence R>
+	class unbounded_zipper
+	{
+
+	private:
+
+		S first;
+		R second;
+
+	public:
+
+		using value_type = std::tuple<sequence_type_t<S>, sequence_type_t<R>>;
+
+		constexpr unbounded_zipper (S first, R second)
+			noexcept(std::is_nothrow_move_constructible<S>::value and std::is_nothrow_move_constructible<R>::value)
+			: first(std::move(first)), second(std::move(second))
+		{}
+
+		/// Returns the tuple of elements at \a index of both indexed sequences
+		constexpr value_type at (std::size_t index) const
+			requires IndexedUnboundedSequence<S> and IndexedUnboundedSequence<R>
+		{
+			return value_type(first.at(index), second.at(index));
+		}
+
+		/// Returns the zipper of the tuples from \a index of both indexed sequences
+		constexpr unbounded_zipper drop (std::size_t index) const
+			requires IndexedUnboundedSequence<S> and IndexedUnboundedSequence<R>
+		{
+			return unbounded_zipper(first.drop(index), second.drop(index));
+		}
+
+		constexpr std::tuple<value_type, unbounded_zipper> decompose () const
+		{
+			auto firsts = first.decompose();
+			auto seconds = second.decompose();
+			auto element = value_type(std::get<0>(firsts), std::get<0>(seconds));
+			auto remainings = unbounded_zipper(std::move(std::get<1>(firsts)), std::move(std::get<1>(seconds)));
+			return std::make_tuple(std::move(element), std::move(remainings));
+		}
+
+		template <typename V, Callable<std::tuple<V, bool>, V, value_type> C>
+		constexpr std::tuple<V, unbounded_zipper> fold (C combiner, V value) const
+		{
+			auto other = second;
+			auto folding = first.fold([&combiner, &other](V value, auto && element)
+			{
+				auto decomposition = other.decompose();
+				auto combination = combiner(std::move(value), value_type(std::forward<decltype(element)>(element), std::move(std::get<0>(decomposition))));
+				if (std::get<1>(combination))
+					other = std::move(std::get<1>(decomposition));
+				return combination;
+			}, std::move(value));
+			return std::make_tuple(std::move(std::get<0>(folding)), unbounded_zipper(std::move(std::get<1>(folding)), std::move(other)));
+		}
+
+	};
+
+
+
+	/// Chunk sequencer for array views
+	///
+	/// The sequencer yields consecutive subviews of \a size values, only the last one may be
+	/// shorter. No value is copied. It models an indexed bounded sequence.
+	template <typename T>
+	class view_chunker
+	{
+
+	private:
+
+		array_view<T> view;
+		std::size_t size;
+
+	public:
+
+		using value_type = array_view<T>;
+
+		constexpr view_chunker (array_view<T> view, std::size_t size)
+			: view(view), size(size)
+		{
+			assert(size > 0);
+		}
+
+		constexpr bool empty () const
+		{
+			return view.empty();
+		}
+
+		constexpr std::size_t length () const
+		{
+			return (view.length() + size - 1) / size;
+		}
+
+		constexpr array_view<T> at (std::size_t index) const
+		{
+			assert(index < length());
+			return std::get<0>(std::get<1>(view.split(index * size)).split(size));
+		}
+
+		constexpr std::tuple<view_chunker, view_chunker> split (std::size_t index) const
+		{
+			const auto count = length();
+			const auto cut = index < count ? index : count;
+			auto splitting = view.split(cut * size);
+			return std::make_tuple(view_chunker(std::get<0>(splitting), size), view_chunker(std::get<1>(splitting), size));
+		}
+
+		constexpr optional<std::tuple<array_view<T>, view_chunker>> decompose () const
+		{
+			using U = optional<std::tuple<array_view<T>, view_chunker>>;
+			if (view.empty())
+				return U();
+			auto splitting = view.split(size);
+			return U(std::make_tuple(std::get<0>(splitting), view_chunker(std::get<1>(splitting), size)));
+		}
+
+		template <typename V, Callable<V, V, array_view<T>> C>
+		constexpr V fold (C combiner, V value) const
+		{
+			const auto count = length();
+			for (std::size_t index = 0; index < count; ++index)
+				value = combiner(std::move(value), at(index));
+			return value;
+		}
+
+		template <typename V, Callable<std::tuple<V, bool>, V, array_view<T>> C>
+		constexpr std::tuple<V, view_chunker, view_chunker> fold (C combiner, V value) const
+		{
+			const auto count = length();
+			auto index = std::size_t(0);
+			auto keepOn = true;
+			while (keepOn and index < count)
+			{
+				std::tie(value, keepOn) = combiner(std::move(value), at(index));
+				if (keepOn) ++index;
+			}
+			auto splitting = split(index);
+			return std::make_tuple(std::move(value), std::get<0>(splitting), std::get<1>(splitting));
+		}
+
+	};
+
+	/// Chunk sequencer for bounded sequences
+	///
+	/// The sequencer yields consecutive subsequences of \a size elements, only the last one may be
+	/// shorter. Each chunk is a count based take sequencer on the held sequence, so no element is
+	/// buffered and nothing is allocated. If the held sequence is indexed, so is the sequencer.
+	/// Otherwise each element is computed twice, once when its chunk is traversed and once when
+	/// the chunk is skipped to reach the next one. For costly elements, the held sequence should
+	/// be memoized with memoize first.
+	template <BoundedSequence S>
+	class bounded_chunker
+	{
+
+	private:
+
+		S sequence;
+		std::size_t size;
+
+	public:
+
+		using value_type = bounded_ntaker<S>;
+
+		constexpr bounded_chunker (S sequence, std::size_t size)
+			noexcept(std::is_nothrow_move_constructible<S>::value)
+			: sequence(std::move(sequence)), size(size)
+		{
+			assert(size > 0);
+		}
+
+		constexpr bool empty () const
+		{
+			return sequence.empty();
+		}
+
+		constexpr std::size_t length () const
+		{
+			return (sequence.length() + size - 1) / size;
+		}
+
+		/// Returns the chunk at \a index of an indexed sequence
+		constexpr value_type at (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			assert(index < length());
+			const auto begin = index * size;
+			const auto rest = sequence.length() - begin;
+			return value_type(std::get<0>(std::get<1>(sequence.split(begin)).split(size)), rest < size ? rest : size, true);
+		}
+
+		/// Splits an indexed sequence before the chunk at \a index
+		constexpr std::tuple<bounded_chunker, bounded_chunker> split (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			const auto count = length();
+			const auto cut = index < count ? index : count;
+			auto splitting = sequence.split(cut * size);
+			return std::make_tuple(bounded_chunker(std::move(std::get<0>(splitting)), size), bounded_chunker(std::move(std::get<1>(splitting)), size));
+		}
+
+		constexpr optional<std::tuple<value_type, bounded_chunker>> decompose () const
+		{
+			using U = optional<std::tuple<value_type, bounded_chunker>>;
+			if (sequence.empty())
+				return U();
+			return U(std::make_tuple(value_type(sequence, size, false), bounded_chunker(drop_elements(sequence, size), size)));
+		}
+
+		template <typename V, Callable<V, V, value_type> C>
+		constexpr V fold (C combiner, V value) const
+		{
+			if constexpr (IndexedBoundedSequence<S>)
+			{
+				const auto count = length();
+				for (std::size_t index = 0; index < count; ++index)
+					value = combiner(std::move(value), at(index));
+			}
+			else
+			{
+				auto rest = sequence;
+				while (not rest.empty())
+				{
+					value = combiner(std::move(value), value_type(rest, size, false));
+					rest = drop_elements(rest, size);
+				}
+			}
+			return value;
+		}
+
+		/// Partial folding
+		///
+		/// The chunks are consecutively folded over \a value by \a combiner until it returns a
+		/// false flag. The folded value will be returned along with the chunkers of the passed
+		/// chunks and of the chunks which have not been passed. If the held sequence is not
+		/// indexed, the passed elements are traversed once more to bound the passed chunks.
+		template <typename V, Callable<std::tuple<V, bool>, V, value_type> C>
+		constexpr std::tuple<V, bounded_chunker, bounded_chunker> fold (C combiner, V value) const
+		{
+			auto index = std::size_t(0);
+			auto keepOn = true;
+			if constexpr (IndexedBoundedSequence<S>)
+			{
+				const auto count = length();
+				while (keepOn and index < count)
+				{
+					std::tie(value, keepOn) = combiner(std::move(value), at(index));
+					if (keepOn) ++index;
+				}
+				auto splitting = split(index);
+				return std::make_tuple(std::move(value), std::move(std::get<0>(splitting)), std::move(std::get<1>(splitting)));
+			}
+			else
+			{
+				auto rest = sequence;
+				while (keepOn and not rest.empty())
+				{
+					std::tie(value, keepOn) = combiner(std::move(value), value_type(rest, size, false));
+					if (keepOn)
+					{
+						rest = drop_elements(rest, size);
+						++index;
+					}
+				}
+				auto passed = bounded_chunker(std::get<0>(split_elements(sequence, index * size)), size);
+				return std::make_tuple(std::move(value), std::move(passed), bounded_chunker(std::move(rest), size));
+			}
+		}
+
+	};
+
+
+
+	/// Sliding window sequencer for array views
+	///
+	/// The sequencer yields the subviews of \a size consecutive values starting at each position
+	/// of the view, as long as they are complete. No value is copied. It models an indexed
+	/// bounded sequence.
+	template <typename T>
+	class view_windower
+	{
+
+	private:
+
+		array_view<T> view;
+		std::size_t size;
+
+	public:
+
+		using value_type = array_view<T>;
+
+		constexpr view_windower (array_view<T> view, std::size_t size)
+			: view(view), size(size)
+		{
+			assert(size > 0);
+		}
+
+		constexpr bool empty () const
+		{
+			return view.length() < size;
+		}
+
+		constexpr std::size_t length () const
+		{
+			const auto count = view.length();
+			return count < size ? 0 : count - size + 1;
+		}
+
+		constexpr array_view<T> at (std::size_t index) const
+		{
+			assert(index < length());
+			return array_view<T>(view.data() + index, size);
+		}
+
+		/// Splits the windows before the one at \a index
+		///
+		/// The first windower keeps the values overlapping with the window at \a index.
+		constexpr std::tuple<view_windower, view_windower> split (std::size_t index) const
+		{
+			const auto count = length();
+			const auto cut = index < count ? index : count;
+			const auto pre = array_view<T>(view.data(), cut == 0 ? 0 : cut + size - 1);
+			return std::make_tuple(view_windower(pre, size), view_windower(std::get<1>(view.split(cut)), size));
+		}
+
+		constexpr optional<std::tuple<array_view<T>, view_windower>> decompose () const
+		{
+			using U = optional<std::tuple<array_view<T>, view_windower>>;
+			if (empty())
+				return U();
+			return U(std::make_tuple(at(0), view_windower(std::get<1>(view.split(1)), size)));
+		}
+
+		template <typename V, Callable<V, V, array_view<T>> C>
+		constexpr V fold (C combiner, V value) const
+		{
+			const auto count = length();
+			for (std::size_t index = 0; index < count; ++index)
+				value = combiner(std::move(value), at(index));
+			return value;
+		}
+
+		template <typename V, Callable<std::tuple<V, bool>, V, array_view<T>> C>
+		constexpr std::tuple<V, view_windower, view_windower> fold (C combiner, V value) const
+		{
+			const auto count = length();
+			auto index = std::size_t(0);
+			auto keepOn = true;
+			while (keepOn and index < count)
+			{
+				std::tie(value, keepOn) = combiner(std::move(value), at(index));
+				if (keepOn) ++index;
+			}
+			auto splitting = split(index);
+			return std::make_tuple(std::move(value), std::get<0>(splitting), std::get<1>(splitting));
+		}
+
+	};
+
+	/// Sliding window sequencer for bounded sequences
+	///
+	/// The sequencer yields the subsequences of \a size consecutive elements starting at each
+	/// position of the held sequence, as long as they are complete. Each window is a count based
+	/// take sequencer on the held sequence, so no element is buffered and nothing is allocated.
+	/// If the held sequence is indexed, so is the sequencer. Otherwise each element is computed
+	/// once for each window containing it, so up to \a size times, and once more when the window
+	/// slides past it. For costly elements, the held sequence should be memoized with memoize
+	/// first.
+	template <BoundedSequence S>
+	class bounded_windower
+	{
+
+	private:
+
+		S sequence;
+		std::size_t size;
+
+		/// Returns whether the held sequence holds at least one complete window
+		constexpr bool is_complete () const
+		{
+			if constexpr (IndexedBoundedSequence<S>)
+			{
+				return sequence.length() >= size;
+			}
+			else
+			{
+				auto folding = sequence.fold([limit=size](std::size_t count, auto &&)
+				{
+					const auto isInBound = count < limit;
+					return std::make_tuple(count + (isInBound ? 1 : 0), isInBound);
+				}, std::size_t(0));
+				return std::get<0>(folding) == size;
+			}
+		}
+
+	public:
+
+		using value_type = bounded_ntaker<S>;
+
+		constexpr bounded_windower (S sequence, std::size_t size)
+			noexcept(std::is_nothrow_move_constructible<S>::value)
+			: sequence(std::move(sequence)), size(size)
+		{
+			assert(size > 0);
+		}
+
+		constexpr bool empty () const
+		{
+			return not is_complete();
+		}
+
+		constexpr std::size_t length () const
+		{
+			const auto count = sequence.length();
+			return count < size ? 0 : count - size + 1;
+		}
+
+		/// Returns the window at \a index of an indexed sequence
+		constexpr value_type at (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			assert(index < length());
+			return value_type(std::get<0>(std::get<1>(sequence.split(index)).split(size)), size, true);
+		}
+
+		/// Splits the windows of an indexed sequence before the one at \a index
+		///
+		/// The first windower keeps the elements overlapping with the window at \a index.
+		constexpr std::tuple<bounded_windower, bounded_windower> split (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			const auto count = length();
+			const auto cut = index < count ? index : count;
+			auto pre = std::get<0>(sequence.split(cut == 0 ? 0 : cut + size - 1));
+			auto post = std::get<1>(sequence.split(cut));
+			return std::make_tuple(bounded_windower(std::move(pre), size), bounded_windower(std::move(post), size));
+		}
+
+		constexpr optional<std::tuple<value_type, bounded_windower>> decompose () const
+		{
+			using U = optional<std::tuple<value_type, bounded_windower>>;
+			if (not is_complete())
+				return U();
+			return U(std::make_tuple(value_type(sequence, size, false), bounded_windower(drop_elements(sequence, 1), size)));
+		}
+
+		/// Complete folding
+		///
+		/// The amount of windows is counted once, so completeness is not tested for each window.
+		template <typename V, Callable<V, V, value_type> C>
+		constexpr V fold (C combiner, V value) const
+		{
+			const auto count = length();
+			auto rest = sequence;
+			for (std::size_t index = 0; index < count; ++index)
+			{
+				value = combiner(std::move(value), value_type(rest, size, false));
+				rest = drop_elements(rest, 1);
+			}
+			return value;
+		}
+
+		/// Partial folding
+		///
+		/// The windows are consecutively folded over \a value by \a combiner until it returns a
+		/// false flag. The folded value will be returned along with the windowers of the passed
+		/// windows and of the windows which have not been passed. The passed windower keeps the
+		/// elements overlapping with the first window which has not been passed. If the held
+		/// sequence is not indexed, the passed elements are traversed once more to bound the passed
+		/// windows.
+		template <typename V, Callable<std::tuple<V, bool>, V, value_type> C>
+		constexpr std::tuple<V, bounded_windower, bounded_windower> fold (C combiner, V value) const
+		{
+			const auto count = length();
+			auto rest = sequence;
+			auto index = std::size_t(0);
+			auto keepOn = true;
+			while (keepOn and index < count)
+			{
+				std::tie(value, keepOn) = combiner(std::move(value), value_type(rest, size, false));
+				if (keepOn)
+				{
+					rest = drop_elements(rest, 1);
+					++index;
+				}
+			}
+			auto passed = bounded_windower(std::get<0>(split_elements(sequence, index == 0 ? 0 : index + size - 1)), size);
+			return std::make_tuple(std::move(value), std::move(passed), bounded_windower(std::move(rest), size));
+		}
+
+	};
+
+
+
+	/// Prefix folding sequencer for bounded sequences
+	///
+	/// The sequencer yields the running values of folding the held sequence over \a value by \a
+	/// combiner, one after each element, like prefix sums. The running value is the only state,
+	/// so nothing is buffered. The length equals the one of the held sequence.
+	template <BoundedSequence S, typename V, Callable<V, V, sequence_type_t<S>> C>
+	class bounded_scanner
+	{
+
+	private:
+
+		S sequence;
+		C combiner;
+		V value;
+
+	public:
+
+		using value_type = V;
+
+		constexpr bounded_scanner (S sequence, C combiner, V value)
+			noexcept(std::is_nothrow_move_constructible<S>::value and std::is_nothrow_move_constructible<C>::value and std::is_nothrow_move_constructible<V>::value)
+			: sequence(std::move(sequence)), combiner(std::move(combiner)), value(std::move(value))
+		{}
+
+		constexpr bool empty () const
+		{
+			return sequence.empty();
+		}
+
+		constexpr std::size_t length () const
+		{
+			return sequence.length();
+		}
+
+		constexpr optional<std::tuple<V, bounded_scanner>> decompose () const
+		{
+			return fmap([this](auto decomposition)
+			{
+				auto next = combiner(value, std::move(std::get<0>(decomposition)));
+				auto remainings = bounded_scanner(std::move(std::get<1>(decomposition)), combiner, next);
+				return std::make_tuple(std::move(next), std::move(remainings));
+			}, sequence.decompose());
+		}
+
+		template <typename W, Callable<W, W, V> D>
+		constexpr W fold (D folder, W folded) const
+		{
+			auto running = value;
+			return sequence.fold([this, &folder, &running](W folded, auto && element)
+			{
+				running = combiner(std::move(running), std::forward<decltype(element)>(element));
+				return folder(std::move(folded), running);
+			}, std::move(folded));
+		}
+
+		template <typename W, Callable<std::tuple<W, bool>, W, V> D>
+		constexpr std::tuple<W, bounded_scanner, bounded_scanner> fold (D folder, W folded) const
+		{
+			auto running = value;
+			auto folding = sequence.fold([this, &folder, &running](W folded, auto && element)
+			{
+				auto next = combiner(running, std::forward<decltype(element)>(element));
+				auto combination = folder(std::move(folded), next);
+				if (std::get<1>(combination))
+					running = std::move(next);
+				return combination;
+			}, std::move(folded));
+			auto passed = bounded_scanner(std::move(std::get<1>(folding)), combiner, value);
+			auto rest = bounded_scanner(std::move(std::get<2>(folding)), combiner, std::move(running));
+			return std::make_tuple(std::move(std::get<0>(folding)), std::move(passed), std::move(rest));
+		}
+
+	};
+
+	/// Prefix folding sequencer for unbounded sequences
+	///
+	/// The sequencer yields the running values of folding the held sequence over \a value by \a
+	/// combiner, one after each element.
+	template <UnboundedSequence S, typename V, Callable<V, V, sequence_type_t<S>> C>
+	class unbounded_scanner
+	{
+
+	private:
+
+		S sequence;
+		C combiner;
+		V value;
+
+	public:
+
+		using value_type = V;
+
+		constexpr unbounded_scanner (S sequence, C combiner, V value)
+			noexcept(std::is_nothrow_move_constructible<S>::value and std::is_nothrow_move_constructible<C>::value and std::is_nothrow_move_constructible<V>::value)
+			: sequence(std::move(sequence)), combiner(std::move(combiner)), value(std::move(value))
+		{}
+
+		constexpr std::tuple<V, unbounded_scanner> decompose () const
+		{
+			auto decomposition = sequence.decompose();
+			auto next = combiner(value, std::move(std::get<0>(decomposition)));
+			auto remainings = unbounded_scanner(std::move(std::get<1>(decomposition)), combiner, next);
+			return std::make_tuple(std::move(next), std::move(remainings));
+		}
+
+		template <typename W, Callable<std::tuple<W, bool>, W, V> D>
+		constexpr std::tuple<W, unbounded_scanner> fold (D folder, W folded) const
+		{
+			auto running = value;
+			auto folding = sequence.fold([this, &folder, &running](W folded, auto && element)
+			{
+				auto next = combiner(running, std::forward<decltype(element)>(element));
+				auto combination = folder(std::move(folded), next);
+				if (std::get<1>(combination))
+					running = std::move(next);
+				return combination;
+			}, std::move(folded));
+			return std::make_tuple(std::move(std::get<0>(folding)), unbounded_scanner(std::move(std::get<1>(folding)), combiner, std::move(running)));
+		}
+
+	};
+
+
+
+	/// Stride sequencer for bounded sequences
+	///
+	/// The sequencer yields every element whose position is a multiple of \a step, beginning
+	/// with the first one. If the held sequence is indexed, so is the sequencer, and skipping
+	/// elements takes constant time.
+	template <BoundedSequence S>
+	class bounded_strider
+	{
+
+	private:
+
+		S sequence;
+		std::size_t step;
+
+	public:
+
+		using value_type = sequence_type_t<S>;
+
+		constexpr bounded_strider (S sequence, std::size_t step)
+			noexcept(std::is_nothrow_move_constructible<S>::value)
+			: sequence(std::move(sequence)), step(step)
+		{
+			assert(step > 0);
+		}
+
+		constexpr bool empty () const
+		{
+			return sequence.empty();
+		}
+
+		constexpr std::size_t length () const
+		{
+			return (sequence.length() + step - 1) / step;
+		}
+
+		/// Returns the element at \a index times the step of an indexed sequence
+		constexpr value_type at (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			assert(index < length());
+			return sequence.at(index * step);
+		}
+
+		/// Splits an indexed sequence before the element at \a index times the step
+		constexpr std::tuple<bounded_strider, bounded_strider> split (std::size_t index) const
+			requires IndexedBoundedSequence<S>
+		{
+			const auto count = length();
+			const auto cut = index < count ? index : count;
+			auto splitting = sequence.split(cut * step);
+			return std::make_tuple(bounded_strider(std::move(std::get<0>(splitting)), step), bounded_strider(std::move(std::get<1>(splitting)), step));
+		}
+
+		constexpr optional<std::tuple<value_type, bounded_strider>> decompose () const
+		{
+			return fmap([this](auto decomposition)
+			{
+				auto remainings = bounded_strider(drop_elements(std::get<1>(decomposition), step - 1), step);
+				return std::make_tuple(std::move(std::get<0>(decomposition)), std::move(remainings));
+			}, sequence.decompose());
+		}
+
+		template <typename V, Callable<V, V, value_type> C>
+		constexpr V fold (C combiner, V value) const
+		{
+			if constexpr (IndexedBoundedSequence<S>)
+			{
+				const auto count = length();
+				for (std::size_t index = 0; index < count; ++index)
+					value = combiner(std::move(value), sequence.at(index * step));
+				return value;
+			}
+			else
+			{
+				auto phase = std::size_t(0);
+				return sequence.fold([this, &combiner, &phase](V value, auto && element)
+				{
+					if (phase == 0)
+						value = combiner(std::move(value), std::forward<decltype(element)>(element));
+					phase = phase + 1 == step ? 0 : phase + 1;
+					return value;
+				}, std::move(value));
+			}
+		}
+
+		template <typename V, Callable<std::tuple<V, bool>, V, value_type> C>
+		constexpr std::tuple<V, bounded_strider, bounded_strider> fold (C combiner, V value) const
+		{
+			auto phase = std::size_t(0);
+			auto folding = sequence.fold([this, &combiner, &phase](V value, auto && element)
+			{
+				if (phase == 0)
+				{
+					auto combination = combiner(std::move(value), std::forward<decltype(element)>(element));
+					if (not std::get<1>(combination))
+						return combination;
+					value = std::move(std::get<0>(combination));
+				}
+				phase = phase + 1 == step ? 0 : phase + 1;
+				return std::make_tuple(std::move(value), true);
+			}, std::move(value));
+			auto passed = bounded_strider(std::move(std::get<1>(folding)), step);
+			auto rest = bounded_strider(std::move(std::get<2>(folding)), step);
+			return std::make_tuple(std::move(std::get<0>(folding)), std::move(passed), std::move(rest));
+		}
+
+	};
+
+	/// Stride sequencer for unbounded sequences
+	///
+	/// The sequencer yields every element whose position is a multiple of \a step, beginning
+	/// with the first one. If the held sequence is indexed, so is the sequencer.
+	template <UnboundedSequence S>
+	class unbounded_strider
+	{
+
+	private:
+
+		S sequence;
+		std::size_t step;
+
+	public:
+
+		using value_type = sequence_type_t<S>;
+
+		constexpr unbounded_strider (S sequence, std::size_t step)
+			noexcept(std::is_nothrow_move_constructible<S>::value)
+			: sequence(std::move(sequence)), step(step)
+		{
+			assert(step > 0);
+		}
+
+		/// Returns the element at \a index times the step of an indexed sequence
+		constexpr value_type at (std::size_t index) const
+			requires IndexedUnboundedSequence<S>
+		{
+			return sequence.at(index * step);
+		}
+
+		/// Returns the strider from \a index times the step of an indexed sequence
+		constexpr unbounded_strider drop (std::size_t index) const
+			requires IndexedUnboundedSequence<S>
+		{
+			return unbounded_strider(sequence.drop(index * step), step);
+		}
+
+		constexpr std::tuple<value_type, unbounded_strider> decompose () const
+		{
+			auto decomposition = sequence.decompose();
+			auto remainings = unbounded_strider(drop_elements(std::get<1>(decomposition), step - 1), step);
+			return std::make_tuple(std::move(std::get<0>(decomposition)), std::move(remainings));
+		}
+
+		template <typename V, Callable<std::tuple<V, bool>, V, value_type> C>
+		constexpr std::tuple<V, unbounded_strider> fold (C combiner, V value) const
+		{
+			auto phase = std::size_t(0);
+			auto folding = sequence.fold([this, &combiner, &phase](V value, auto && element)
+			{
+				if (phase == 0)
+				{
+					auto combination = combiner(std::move(value), std::forward<decltype(element)>(element));
+					if (not std::get<1>(combination))
+						return combination;
+					value = std::move(std::get<0>(combination));
+				}
+				phase = phase + 1 == step ? 0 : phase + 1;
+				return std::make_tuple(std::move(value), true);
+			}, std::move(value));
+			return std::make_tuple(std::move(std::get<0>(folding)), unbounded_strider(std::move(std::get<1>(folding)), step));
+		}
+
+	};
+
+
+
+	/// Zips \a first and \a second, of which at least one is bounded
+	template <Sequence S, Sequence R>
+		requires BoundedSequence<S> or BoundedSequence<R>
+	constexpr bounded_zipper<S, R> zip (S first, R second)
+	{
+		return bounded_zipper<S, R>(std::move(first), std::move(second));
+	}
+
+	/// Zips the unbounded sequences \a first and \a second
+	template <UnboundedSequence S, UnboundedSequence R>
+	constexpr unbounded_zipper<S, R> zip (S first, R second)
+	{
+		return unbounded_zipper<S, R>(std::move(first), std::move(second));
+	}
+
+	/// Unzips a bounded \a sequence of pairs
+	///
+	/// The sequences of the first and of the second elements are returned as transformers of \a
+	/// sequence, so both are indexed if \a sequence is.
+	template <BoundedSequence S>
+	constexpr auto unzip (S sequence)
+	{
+		auto firsts = bounded_transformer<S, tuple_getter<0>>(sequence, tuple_getter<0>());
+		auto seconds = bounded_transformer<S, tuple_getter<1>>(std::move(sequence), tuple_getter<1>());
+		return std::make_tuple(std::move(firsts), std::move(seconds));
+	}
+
+	/// Unzips an unbounded \a sequence of pairs
+	template <UnboundedSequence S>
+	constexpr auto unzip (S sequence)
+	{
+		auto firsts = unbounded_transformer<S, tuple_getter<0>>(sequence, tuple_getter<0>());
+		auto seconds = unbounded_transformer<S, tuple_getter<1>>(std::move(sequence), tuple_getter<1>());
+		return std::make_tuple(std::move(firsts), std::move(seconds));
+	}
+
+	/// Splits \a view into consecutive subviews of \a size values
+	template <typename T>
+	constexpr view_chunker<T> chunks (array_view<T> view, std::size_t size)
+	{
+		return view_chunker<T>(view, size);
+	}
+
+	/// Splits \a sequence into consecutive subsequences of \a size elements
+	///
+	/// If \a sequence is not indexed, each element is computed twice. See bounded_chunker.
+	template <BoundedSequence S>
+	constexpr bounded_chunker<S> chunks (S sequence, std::size_t size)
+	{
+		return bounded_chunker<S>(std::move(sequence), size);
+	}
+
+	/// Slides a window of \a size values over \a view
+	template <typename T>
+	constexpr view_windower<T> windows (array_view<T> view, std::size_t size)
+	{
+		return view_windower<T>(view, size);
+	}
+
+	/// Slides a window of \a size elements over \a sequence
+	///
+	/// If \a sequence is not indexed, each element is computed up to \a size times. See
+	/// bounded_windower.
+	template <BoundedSequence S>
+	constexpr bounded_windower<S> windows (S sequence, std::size_t size)
+	{
+		return bounded_windower<S>(std::move(sequence), size);
+	}
+
+	/// Running values of folding the bounded \a sequence over \a value by \a combiner
+	template <typename V, BoundedSequence S, Callable<V, V, sequence_type_t<S>> C>
+	constexpr bounded_scanner<S, V, C> scan (C combiner, V value, S sequence)
+	{
+		return bounded_scanner<S, V, C>(std::move(sequence), std::move(combiner), std::move(value));
+	}
+
+	/// Running values of folding the unbounded \a sequence over \a value by \a combiner
+	template <typename V, UnboundedSequence S, Callable<V, V, sequence_type_t<S>> C>
+	constexpr unbounded_scanner<S, V, C> scan (C combiner, V value, S sequence)
+	{
+		return unbounded_scanner<S, V, C>(std::move(sequence), std::move(combiner), std::move(value));
+	}
+
+	/// Pairs each element of \a sequence with its position
+	///
+	/// The positions are an indexed unbounded sequence, so the result is indexed if \a sequence
+	/// is.
+	template <Sequence S>
+	constexpr auto enumerate (S sequence)
+	{
+		return zip(unbounded_iota<std::size_t>(0), std::move(sequence));
+	}
+
+	/// Every element of \a sequence at a multiple of \a step
+	template <BoundedSequence S>
+	constexpr bounded_strider<S> stride (S sequence, std::size_t step)
+	{
+		return bounded_strider<S>(std::move(sequence), step);
+	}
+
+	/// Every element of the unbounded \a sequence at a multiple of \a step
+	template <UnboundedSequence S>
+	constexpr unbounded_strider<S> stride (S sequence, std::size_t step)
+	{
+		return unbounded_strider<S>(std::move(sequence), step);
+	}
+
+}
+
+#endif
@@ -85,6 +85,70 @@ namespace stdext
 
 
 
+	/// Concept of an indexed bounded sequence
+	///
+	/// An indexed bounded sequence is a bounded sequence whose elements are directly accessible.
+	/// The method at returns the element at an index, which must be less than the length. The
+	/// method length returns the amount of elements, and the method split returns the sequences of
+	/// the elements before and from an index. All of them take constant time.
+	template <typename S> concept bool IndexedBoundedSequence ()
+	{
+		return BoundedSequence<S> and
+		       requires (S s, std::size_t index)
+		       {
+		         s.at(index);
+		         {s.length()} -> std::size_t;
+		         {s.split(index)} -> std::tuple<S, S>;
+		       };
+	}
+
+	/// Concept of an indexed unbounded sequence
+	///
+	/// An indexed unbounded sequence is an unbounded sequence whose elements are directly
+	/// accessible. The method at returns the element at an index, and the method drop returns the
+	/// sequence of the elements from an index. Both of them take constant time.
+	template <typename S> concept bool IndexedUnboundedSequence ()
+	{
+		return UnboundedSequence<S> and
+		       requires (S s, std::size_t index)
+		       {
+		         s.at(index);
+		         {s.drop(index)} -> S;
+		       };
+	}
+
+
+
+	/// Maximal amount of elements which sequencers buffer for one chunk
+	constexpr std::size_t sequenceChunkLength = 256;
+
+	/// Combiner accepting any chunk, with which chunked sequences are detected
+	struct chunk_probe
+	{
+		template <typename C>
+		constexpr int operator () (int value, C) const
+		{
+			return value;
+		}
+	};
+
+	/// Concept of a chunked sequence
+	///
+	/// A chunked sequence is a bounded sequence whose elements are laid out in contiguous memory,
+	/// at least in parts. Additionally to folding element by element, it implements the method
+	/// fold_chunks, which folds array views of consecutive elements over a value. Sequencers can
+	/// process whole chunks in tight loops, which the compiler is able to vectorize.
+	template <typename S> concept bool ChunkedSequence ()
+	{
+		return BoundedSequence<S> and
+		       requires (S s)
+		       {
+		         s.fold_chunks(chunk_probe(), int(0));
+		       };
+	}
+
+
+
 	/// Trait of sequence's element type
 	template <typename S> struct sequence_type {};
 	template <BoundedSequence S> struct sequence_type<S>
@@ -0,0 +1,357 @@
+/// @file set_operations.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_SET_OPERATIONS_HPP__
+#define __STDEXT_SET_OPERATIONS_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/array.hpp>
+#include <stdext/array_view.hpp>
+#include <stdext/sorting_network.hpp>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace stdext
+{
+
+	/// Ratio of lengths from which on the shorter set is galloped through the longer one
+	constexpr std::size_t gallopingSkew = 32;
+
+	/// Whether sets of values of type \a T compared with \a C are compared in blocks of four
+	///
+	/// This is the case for 32 bit integers compared with their less-than operator, if SSE2 is
+	/// available.
+	template <typename T, typename C>
+	constexpr bool is_block_comparison_applicable_v =
+#if defined(__SSE2__)
+		(std::is_same<std::remove_const_t<T>, std::uint32_t>::value or std::is_same<std::remove_const_t<T>, std::int32_t>::value)
+		and is_less_comparer_v<T, C>;
+#else
+		false;
+#endif
+
+
+	/// Exponential search
+	///
+	/// The index of the first of the \a length sorted \a values which is not less than \a value
+	/// will be returned. The search probes indices of growing powers of two before searching
+	/// binarily, so it costs the logarithm of the returned index instead of the length.
+	template <typename T, Callable<bool, const T&, const T&> C>
+	std::size_t gallop_lower_bound (C & comparer, const T * values, std::size_t length, const T & value)
+	{
+		auto bound = std::size_t(1);
+		while (bound <= length and comparer(values[bound - 1], value))
+			bound *= 2;
+
+		auto begin = bound / 2;
+		auto end = bound - 1 < length ? bound - 1 : length;
+		while (begin < end)
+		{
+			const auto middle = begin + (end - begin) / 2;
+			if (comparer(values[middle], value))
+				begin = middle + 1;
+			else
+				end = middle;
+		}
+		return begin;
+	}
+
+	/// Visits all values which are contained in both sorted sets \a first and \a second
+	///
+	/// The \a visitor is called with the value of \a first of each common value in ascending
+	/// order. Depending on the skew of the lengths, the shorter set is galloped through the longer
+	/// one, or both sets are merged linearly, in blocks of four values if possible.
+	template <typename T, Callable<bool, const T&, const T&> C, Callable_<const T&> V>
+	void visit_intersection (C & comparer, array_view<const T> first, array_view<const T> second, V visitor)
+	{
+		const T * a = first.data();
+		const T * b = second.data();
+		const auto aLength = first.length();
+		const auto bLength = second.length();
+		auto i = std::size_t(0);
+		auto j = std::size_t(0);
+
+		if (aLength * gallopingSkew <= bLength)
+		{
+			while (i < aLength and j < bLength)
+			{
+				j += gallop_lower_bound(comparer, b + j, bLength - j, a[i]);
+				if (j < bLength and not comparer(a[i], b[j]))
+				{
+					visitor(a[i]);
+					++j;
+				}
+				++i;
+			}
+			return;
+		}
+
+		if (bLength * gallopingSkew <= aLength)
+		{
+			// the second set is galloped through the first one, whose values are visited
+			while (i < aLength and j < bLength)
+			{
+				i += gallop_lower_bound(comparer, a + i, aLength - i, b[j]);
+				if (i < aLength and not comparer(b[j], a[i]))
+				{
+					visitor(a[i]);
+					++i;
+				}
+				++j;
+			}
+			return;
+		}
+
+#if defined(__SSE2__)
+		if constexpr (is_block_comparison_applicable_v<T, C>)
+		{
+			// each block of the first set is compared against all rotations of a block of the second
+			while (i + 4 <= aLength and j + 4 <= bLength)
+			{
+				const auto aBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+				const auto bBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+				auto matches = _mm_cmpeq_epi32(aBlock, bBlock);
+				matches = _mm_or_si128(matches, _mm_cmpeq_epi32(aBlock, _mm_shuffle_epi32(bBlock, 0x39)));
+				matches = _mm_or_si128(matches, _mm_cmpeq_epi32(aBlock, _mm_shuffle_epi32(bBlock, 0x4E)));
+				matches = _mm_or_si128(matches, _mm_cmpeq_epi32(aBlock, _mm_shuffle_epi32(bBlock, 0x93)));
+				const auto mask = _mm_movemask_ps(_mm_castsi128_ps(matches));
+				for (auto index = 0; index < 4; ++index)
+				{
+					if (mask & (1 << index))
+						visitor(a[i + index]);
+				}
+
+				const auto aLast = a[i + 3];
+				const auto bLast = b[j + 3];
+				i += aLast <= bLast ? 4 : 0;
+				j += bLast <= aLast ? 4 : 0;
+			}
+		}
+#endif
+
+		while (i < aLength and j < bLength)
+		{
+			if (comparer(a[i], b[j]))
+			{
+				++i;
+			}
+			else if (comparer(b[j], a[i]))
+			{
+				++j;
+			}
+			else
+			{
+				visitor(a[i]);
+				++i;
+				++j;
+			}
+		}
+	}
+
+
+	/// Set intersection
+	///
+	/// All values which are contained in both \a first and \a second will be appended to \a
+	/// destination in ascending order, as in \a first. Both views must be sorted by \a comparer
+	/// without any equivalent values. If the lengths are skewed, each value of the shorter view is
+	/// searched exponentially in the longer one, otherwise both views are merged linearly. Sets of
+	/// 32 bit integers are compared in blocks of four values, if SSE2 is available.
+	///
+	/// @param comparer     A callable object which takes two constant references of type \a T and
+	///                     returns a boolean indicating if both values are in right order
+	/// @param first        First sorted set
+	/// @param second       Second sorted set
+	/// @param destination  Array to which the common values are appended
+	///
+	/// @note Time complexity is m*log(n/m) with m being the length of the shorter and n being the
+	///       length of the longer set.
+	///
+	template <typename T, Callable<bool, const T&, const T&> C, Allocator A>
+	void intersect_sorted (C comparer, array_view<const T> first, array_view<const T> second, array<T, A> & destination)
+	{
+		const auto shorter = first.length() < second.length() ? first.length() : second.length();
+		destination.reserve(destination.length() + shorter);
+		visit_intersection(comparer, first, second, [&destination](const T & value)
+		{
+			destination.append(value);
+		});
+	}
+
+	/// Set intersection counting
+	///
+	/// The amount of values which are contained in both \a first and \a second will be returned.
+	/// Both views must be sorted by \a comparer without any equivalent values. See intersect_sorted
+	/// for the choice of algorithm.
+	///
+	/// @note Time complexity is m*log(n/m) with m being the length of the shorter and n being the
+	///       length of the longer set.
+	///
+	template <typename T, Callable<bool, const T&, const T&> C>
+	std::size_t intersect_count (C comparer, array_view<const T> first, array_view<const T> second)
+	{
+		auto count = std::size_t(0);
+		visit_intersection(comparer, first, second, [&count](const T &)
+		{
+			++count;
+		});
+		return count;
+	}
+
+	/// Set union
+	///
+	/// All values which are contained in \a first or \a second will be appended to \a destination
+	/// in ascending order. Both views must be sorted by \a comparer without any equivalent values.
+	/// Values contained in both views are appended once, as in \a first. If the lengths are
+	/// skewed, the values of the longer view between two values of the shorter one are found
+	/// exponentially and appended at once.
+	///
+	/// @param comparer     A callable object which takes two constant references of type \a T and
+	///                     returns a boolean indicating if both values are in right order
+	/// @param first        First sorted set
+	/// @param second       Second sorted set
+	/// @param destination  Array to which the values of both sets are appended
+	///
+	/// @note Time complexity is linear in the length of the union.
+	///
+	template <typename T, Callable<bool, const T&, const T&> C, Allocator A>
+	void union_sorted (C comparer, array_view<const T> first, array_view<const T> second, array<T, A> & destination)
+	{
+		destination.reserve(destination.length() + first.length() + second.length());
+
+		// common values are still taken from the first set after swapping
+		const auto isSwapped = first.length() > second.length();
+		if (isSwapped)
+			std::swap(first, second);
+
+		const T * a = first.data();
+		const T * b = second.data();
+		const auto aLength = first.length();
+		const auto bLength = second.length();
+		auto i = std::size_t(0);
+		auto j = std::size_t(0);
+
+		if (aLength * gallopingSkew <= bLength)
+		{
+			for (; i < aLength; ++i)
+			{
+				const auto lower = gallop_lower_bound(comparer, b + j, bLength - j, a[i]);
+				destination.append(array_view<const T>(b + j, lower));
+				j += lower;
+				if (j < bLength and not comparer(a[i], b[j]))
+				{
+					destination.append(isSwapped ? b[j] : a[i]);
+					++j;
+				}
+				else
+				{
+					destination.append(a[i]);
+				}
+			}
+		}
+		else
+		{
+			while (i < aLength and j < bLength)
+			{
+				if (comparer(a[i], b[j]))
+				{
+					destination.append(a[i]);
+					++i;
+				}
+				else if (comparer(b[j], a[i]))
+				{
+					destination.append(b[j]);
+					++j;
+				}
+				else
+				{
+					destination.append(isSwapped ? b[j] : a[i]);
+					++i;
+					++j;
+				}
+			}
+			destination.append(array_view<const T>(a + i, aLength - i));
+		}
+		destination.append(array_view<const T>(b + j, bLength - j));
+	}
+
+	/// Set difference
+	///
+	/// All values which are contained in \a first but not in \a second will be appended to \a
+	/// destination in ascending order. Both views must be sorted by \a comparer without any
+	/// equivalent values. If \a first is much shorter, its values are searched exponentially in
+	/// \a second. If \a second is much shorter, the values of \a first between two values of \a
+	/// second are found exponentially and appended at once.
+	///
+	/// @param comparer     A callable object which takes two constant references of type \a T and
+	///                     returns a boolean indicating if both values are in right order
+	/// @param first        Sorted set whose values are appended
+	/// @param second       Sorted set whose values are excluded
+	/// @param destination  Array to which the remaining values of \a first are appended
+	///
+	/// @note Time complexity is m*log(n/m) with m being the length of the shorter and n being the
+	///       length of the longer set, plus the length of the difference.
+	///
+	template <typename T, Callable<bool, const T&, const T&> C, Allocator A>
+	void difference_sorted (C comparer, array_view<const T> first, array_view<const T> second, array<T, A> & destination)
+	{
+		destination.reserve(destination.length() + first.length());
+
+		const T * a = first.data();
+		const T * b = second.data();
+		const auto aLength = first.length();
+		const auto bLength = second.length();
+		auto i = std::size_t(0);
+		auto j = std::size_t(0);
+
+		if (aLength * gallopingSkew <= bLength)
+		{
+			for (; i < aLength; ++i)
+			{
+				j += gallop_lower_bound(comparer, b + j, bLength - j, a[i]);
+				if (j == bLength or comparer(a[i], b[j]))
+					destination.append(a[i]);
+				else
+					++j;
+			}
+			return;
+		}
+		else if (bLength * gallopingSkew <= aLength)
+		{
+			for (; j < bLength and i < aLength; ++j)
+			{
+				const auto lower = gallop_lower_bound(comparer, a + i, aLength - i, b[j]);
+				destination.append(array_view<const T>(a + i, lower));
+				i += lower;
+				if (i < aLength and not comparer(b[j], a[i]))
+					++i;
+			}
+		}
+		else
+		{
+			while (i < aLength and j < bLength)
+			{
+				if (comparer(a[i], b[j]))
+				{
+					destination.append(a[i]);
+					++i;
+				}
+				else
+				{
+					if (not comparer(b[j], a[i]))
+						++i;
+					++j;
+				}
+			}
+		}
+		destination.append(array_view<const T>(a + i, aLength - i));
+	}
+
+}
+
+#endif
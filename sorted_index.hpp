@@ -0,0 +1,154 @@
+/// @file sorted_index.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_SORTED_INDEX_HPP__
+#define __STDEXT_SORTED_INDEX_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/allocator.hpp>
+#include <stdext/array_view.hpp>
+#include <stdext/optional.hpp>
+#include <new>
+
+namespace stdext
+{
+
+	/// Search index over sorted values in Eytzinger layout
+	///
+	/// The index holds a copy of sorted values which are placed in breadth first order of the
+	/// implicit binary search tree, also known as Eytzinger layout. The first levels of the tree
+	/// share few cache lines, and the values probed next are placed next to each other, so they
+	/// can be prefetched several levels ahead. Lookups are branchless. The index does not change
+	/// after its construction. The order is defined by \a C and memory is allocated from \a A.
+	template <typename T, Callable<bool, const T&, const T&> C, Allocator A = system_allocator>
+	class sorted_index
+	{
+
+	private:
+
+		using allocation_type = allocation_type_t<A, T>;
+
+		C comparer;
+		A allocator;
+		allocation_type allocation;
+		std::size_t count = 0;
+
+
+		/// Copies the \a sorted values in order into the subtree at \a node
+		///
+		/// Nodes are numbered from one, so node \a k is placed at index \a k - 1 and its children
+		/// are the nodes 2 \a k and 2 \a k + 1. The amount of copied values is returned.
+		std::size_t construct (const T * sorted, std::size_t node)
+		{
+			if (node > count)
+				return 0;
+
+			auto copied = construct(sorted, node * 2);
+			new (allocation.data() + node - 1) T(sorted[copied]);
+			++copied;
+			return copied + construct(sorted + copied, node * 2 + 1);
+		}
+
+		/// Returns the node of the first value which is not less than \a value or zero
+		std::size_t lower_bound_node (const T & value) const
+		{
+			const T * nodes = allocation.data();
+			auto node = std::size_t(1);
+			while (node <= count)
+			{
+#if defined(__GNUC__)
+				// values four levels below are placed next to each other
+				__builtin_prefetch(nodes + node * 16 - 1);
+#endif
+				node = node * 2 + (comparer(nodes[node - 1], value) ? 1 : 0);
+			}
+
+			// the last turn to the left is where the search has passed the searched value
+			while (node & 1)
+				node = node / 2;
+			return node / 2;
+		}
+
+	public:
+
+		/// Construction from \a sorted values with \a comparer and \a allocator
+		///
+		/// The \a sorted values must be sorted by \a comparer. They will be copied into memory from
+		/// \a allocator. If not enough memory could be allocated, the exception \a bad_alloc will
+		/// be thrown.
+		sorted_index (array_view<const T> sorted, C comparer, A allocator)
+			: comparer(std::move(comparer)), allocator(std::move(allocator)), count(sorted.length())
+		{
+			allocation = this->allocator.template allocate<T>(count);
+			if (allocation.length() < count)
+			{
+				this->allocator.deallocate(allocation);
+				throw bad_alloc("sorted index cannot be allocated");
+			}
+			construct(sorted.data(), 1);
+		}
+
+		/// Construction from \a sorted values with \a comparer
+		///
+		/// The allocator will be default constructed.
+		sorted_index (array_view<const T> sorted, C comparer)
+			: sorted_index(sorted, std::move(comparer), A())
+		{}
+
+		sorted_index (const sorted_index &) = delete;
+		sorted_index& operator = (const sorted_index &) = delete;
+
+		/// Destructor
+		///
+		/// All copied values will be destructed and the memory will be deallocated.
+		~sorted_index ()
+		{
+			for (std::size_t index = 0; index < count; ++index)
+				allocation.data()[index].~T();
+			allocator.deallocate(allocation);
+		}
+
+		/// Returns the amount of indexed values
+		constexpr std::size_t length () const
+		{
+			return count;
+		}
+
+		/// Returns whether no value is indexed
+		constexpr bool empty () const
+		{
+			return count == 0;
+		}
+
+		/// Lower bound lookup
+		///
+		/// A reference to the first indexed value which is not less than \a value will be returned.
+		/// If all indexed values are less than \a value, an empty optional container will be
+		/// returned.
+		///
+		/// @note Time complexity is logarithmic in the amount of indexed values.
+		///
+		optional<const T&> lower_bound (const T & value) const
+		{
+			const auto node = lower_bound_node(value);
+			return node == 0 ? optional<const T&>() : optional<const T&>(allocation.data() + node - 1);
+		}
+
+		/// Containment test
+		///
+		/// Returns whether some indexed value is equivalent to \a value.
+		///
+		/// @note Time complexity is logarithmic in the amount of indexed values.
+		///
+		bool contains (const T & value) const
+		{
+			const auto node = lower_bound_node(value);
+			return node != 0 and not comparer(value, allocation.data()[node - 1]);
+		}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+/// @file sorting_network.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_SORTING_NETWORK_HPP__
+#define __STDEXT_SORTING_NETWORK_HPP__
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace stdext
+{
+
+	/// Less-than comparer
+	///
+	/// Compares two values with their less-than operator. Sorting arithmetic values with this
+	/// comparer allows using sorting networks for small ranges.
+	struct less
+	{
+		template <typename T>
+		constexpr bool operator () (const T & a, const T & b) const
+		{
+			return a < b;
+		}
+	};
+
+
+	/// Whether \a C compares values of type \a T with their less-than operator
+	template <typename T, typename C>
+	constexpr bool is_less_comparer_v = std::is_same<C, less>::value
+		or std::is_same<C, std::less<std::remove_const_t<T>>>::value
+		or std::is_same<C, std::less<>>::value;
+
+
+	/// Largest length which is sorted by a sorting network
+	constexpr std::size_t maxSortingNetworkLength = 32;
+
+	/// Whether values of type \a T compared with \a C can be sorted by sorting networks
+	///
+	/// This is the case for non-constant arithmetic values compared with their less-than
+	/// operator, since only then comparing and exchanging can be done without branches.
+	template <typename T, typename C>
+	constexpr bool is_sorting_network_applicable_v = std::is_arithmetic<T>::value
+		and not std::is_const<T>::value
+		and is_less_comparer_v<T, C>;
+
+
+	/// Visits the comparators of Batcher's odd-even merge sort for \a length values
+	///
+	/// The \a visitor is called with the lower and the upper index of each comparator in the
+	/// order in which the comparators have to be applied.
+	template <typename V>
+	constexpr void visit_sorting_network (std::size_t length, V visitor)
+	{
+		for (std::size_t p = 1; p < length; p += p)
+		{
+			for (std::size_t k = p; k > 0; k /= 2)
+			{
+				for (std::size_t j = k % p; j + k < length; j += 2 * k)
+				{
+					for (std::size_t i = 0; i < k and i + j + k < length; ++i)
+					{
+						if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+							visitor(i + j, i + j + k);
+					}
+				}
+			}
+		}
+	}
+
+	/// Sorting network for \a N values
+	///
+	/// The comparators are generated at compile time and applied unrolled, such that each
+	/// comparator becomes a minimum and a maximum instruction.
+	template <std::size_t N> class sorting_network
+	{
+
+	private:
+
+		struct comparator
+		{
+			std::size_t lower = 0;
+			std::size_t upper = 0;
+		};
+
+		static constexpr std::size_t count ()
+		{
+			auto count = std::size_t(0);
+			visit_sorting_network(N, [&](std::size_t, std::size_t){++count;});
+			return count;
+		}
+
+		static constexpr std::array<comparator, count()> generate ()
+		{
+			auto comparators = std::array<comparator, count()>();
+			auto index = std::size_t(0);
+			visit_sorting_network(N, [&](std::size_t lower, std::size_t upper)
+			{
+				comparators[index++] = comparator{lower, upper};
+			});
+			return comparators;
+		}
+
+		static constexpr auto comparators = generate();
+
+
+		template <typename T>
+		static constexpr void compare_exchange (T & lower, T & upper)
+		{
+			const auto a = lower;
+			const auto b = upper;
+			lower = b < a ? b : a;
+			upper = b < a ? a : b;
+		}
+
+		template <typename T, std::size_t ... I>
+		static constexpr void apply (T * values, std::index_sequence<I ...>)
+		{
+			(void)values;
+			(compare_exchange(values[comparators[I].lower], values[comparators[I].upper]), ...);
+		}
+
+	public:
+
+		/// Sorts the \a N values beginning at \a values ascendingly
+		template <typename T>
+		static constexpr void sort (T * values)
+		{
+			static_assert(std::is_arithmetic<T>::value, "Only arithmetic values can be sorted by networks!");
+			apply(values, std::make_index_sequence<comparators.size()>());
+		}
+
+	};
+
+
+	template <typename T, std::size_t ... N>
+	constexpr void sort_by_network (T * values, std::size_t length, std::index_sequence<N ...>)
+	{
+		constexpr void (*sorters[])(T *) = {&sorting_network<N>::template sort<T> ...};
+		sorters[length](values);
+	}
+
+	/// Sorts \a length values beginning at \a values ascendingly with a sorting network
+	///
+	/// The \a length must not be greater than \a maxSortingNetworkLength.
+	template <typename T>
+	constexpr void sort_by_network (T * values, std::size_t length)
+	{
+		assert(length <= maxSortingNetworkLength);
+		sort_by_network(values, length, std::make_index_sequence<maxSortingNetworkLength + 1>());
+	}
+
+}
+
+#endif
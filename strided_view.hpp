@@ -0,0 +1,359 @@
+/// @file strided_view.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_STRIDED_VIEW_HPP__
+#define __STDEXT_STRIDED_VIEW_HPP__
+
+#include <stdext/callable.hpp>
+#include <stdext/array_view.hpp>
+#include <stdext/optional.hpp>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace stdext
+{
+
+	/// Amount of bytes a tile of cache-blocked kernels spans at most
+	constexpr std::size_t blockingTileSize = 16384;
+
+	/// Returns the edge length of square tiles for blocked kernels on values of size \a size
+	///
+	/// The edge length is the greatest power of two such that a tile spans at most \a
+	/// blockingTileSize bytes.
+	constexpr std::size_t blocking_tile_edge (std::size_t size)
+	{
+		auto edge = std::size_t(1);
+		while ((edge * 2) * (edge * 2) * size <= blockingTileSize)
+			edge *= 2;
+		return edge;
+	}
+
+
+	/// View on an arbitrary multi-dimensional array with strides
+	///
+	/// The view spans \a N dimensions, each with an extent and a stride, which is the distance
+	/// between two consecutive values of the dimension in amount of values. Like an array view, the
+	/// strided view does not manage the underlying memory. It can be sliced into views with fewer
+	/// dimensions and tiled into smaller views without copying any value. Kernels traverse the
+	/// values in the order of memory, regardless of how the dimensions are laid out.
+	template <typename T, std::size_t N = 2> class strided_view
+	{
+
+		static_assert(N > 0, "Strided view must have at least one dimension!");
+
+		template <typename U, std::size_t M> friend class strided_view;
+
+	private:
+
+		T * values = nullptr;
+		std::array<std::size_t, N> extents = {};
+		std::array<std::size_t, N> strides = {};
+
+
+		/// Visits each value with \a visitor in order of memory
+		///
+		/// The dimensions are traversed from greatest to least stride, so the innermost loop walks
+		/// through contiguous memory if possible.
+		template <typename V>
+		constexpr void visit (V & visitor) const
+		{
+			if (empty())
+				return;
+
+			auto order = std::array<std::size_t, N>();
+			for (std::size_t dimension = 0; dimension < N; ++dimension)
+			{
+				auto index = dimension;
+				while (index > 0 and strides[order[index-1]] < strides[dimension])
+				{
+					order[index] = order[index-1];
+					--index;
+				}
+				order[index] = dimension;
+			}
+			visit(visitor, order, 0, values);
+		}
+
+		/// Visits the values of all dimensions from \a depth in \a order beginning at \a base
+		template <typename V>
+		constexpr void visit (V & visitor, const std::array<std::size_t, N> & order, std::size_t depth, T * base) const
+		{
+			const auto dimension = order[depth];
+			const auto extent = extents[dimension];
+			const auto stride = strides[dimension];
+			if (depth + 1 == N)
+			{
+				for (std::size_t index = 0; index < extent; ++index)
+					visitor(base[index * stride]);
+			}
+			else
+			{
+				for (std::size_t index = 0; index < extent; ++index)
+					visit(visitor, order, depth + 1, base + index * stride);
+			}
+		}
+
+	public:
+
+		/// Constructs an empty view
+		constexpr strided_view () = default;
+
+		/// Constructs a view on \a values with \a extents and \a strides
+		///
+		/// The strides are given in amount of values. The view must not exceed the underlying
+		/// memory.
+		constexpr strided_view (T * values, std::array<std::size_t, N> extents, std::array<std::size_t, N> strides)
+			: values(values), extents(extents), strides(strides)
+		{}
+
+		/// Constructs a view on the values of \a view with \a extents
+		///
+		/// The values are laid out contiguously with the last dimension varying fastest, as in a
+		/// row major matrix. The \a view must hold at least as many values as the extents span.
+		constexpr strided_view (array_view<T> view, std::array<std::size_t, N> extents)
+			: values(view.data()), extents(extents)
+		{
+			auto stride = std::size_t(1);
+			for (std::size_t dimension = N; dimension > 0; --dimension)
+			{
+				strides[dimension-1] = stride;
+				stride *= extents[dimension-1];
+			}
+			assert(stride <= view.length());
+		}
+
+		/// Converts a view on \a U into a view on \a T, e.g. a mutable into a constant view
+		template <typename U>
+			requires std::is_convertible<U*, T*>::value
+		constexpr strided_view (const strided_view<U, N> & other)
+			: values(other.values), extents(other.extents), strides(other.strides)
+		{}
+
+		/// Returns the pointer to the first value
+		constexpr T * data () const
+		{
+			return values;
+		}
+
+		/// Returns the extent of \a dimension
+		constexpr std::size_t extent (std::size_t dimension) const
+		{
+			assert(dimension < N);
+			return extents[dimension];
+		}
+
+		/// Returns the stride of \a dimension in amount of values
+		constexpr std::size_t stride (std::size_t dimension) const
+		{
+			assert(dimension < N);
+			return strides[dimension];
+		}
+
+		/// Returns the amount of values in the view
+		constexpr std::size_t length () const
+		{
+			auto length = std::size_t(1);
+			for (const auto extent : extents)
+				length *= extent;
+			return length;
+		}
+
+		/// Returns whether the view contains no value
+		constexpr bool empty () const
+		{
+			return length() == 0;
+		}
+
+		/// Indexing
+		///
+		/// If all \a indices are in bound, a reference to the corresponding value will be returned.
+		/// Otherwise, an empty optional container will be returned.
+		template <typename ... Is>
+			requires (sizeof...(Is) == N and (std::is_convertible<Is, std::size_t>::value and ...))
+		constexpr optional<T&> at (Is ... indices) const
+		{
+			const auto position = std::array<std::size_t, N>{static_cast<std::size_t>(indices) ...};
+			auto offset = std::size_t(0);
+			for (std::size_t dimension = 0; dimension < N; ++dimension)
+			{
+				if (position[dimension] >= extents[dimension])
+					return optional<T&>();
+				offset += position[dimension] * strides[dimension];
+			}
+			return optional<T&>(values + offset);
+		}
+
+		/// Slicing
+		///
+		/// A view on all values whose index in \a dimension is \a index will be returned. The view
+		/// has one dimension less. If \a index is out of bound, the returned view is empty.
+		constexpr strided_view<T, N-1> slice (std::size_t dimension, std::size_t index) const
+			requires (N > 1)
+		{
+			assert(dimension < N);
+
+			auto sliced = strided_view<T, N-1>();
+			if (index >= extents[dimension])
+				return sliced;
+
+			sliced.values = values + index * strides[dimension];
+			for (std::size_t from = 0, to = 0; from < N; ++from)
+			{
+				if (from == dimension)
+					continue;
+				sliced.extents[to] = extents[from];
+				sliced.strides[to] = strides[from];
+				++to;
+			}
+			return sliced;
+		}
+
+		/// Returns a view on the row at \a index of a two-dimensional view
+		constexpr strided_view<T, 1> row (std::size_t index) const
+			requires (N == 2)
+		{
+			return slice(0, index);
+		}
+
+		/// Returns a view on the column at \a index of a two-dimensional view
+		constexpr strided_view<T, 1> column (std::size_t index) const
+			requires (N == 2)
+		{
+			return slice(1, index);
+		}
+
+		/// Tiling
+		///
+		/// A view on the values from \a begins spanning \a lengths in each dimension will be
+		/// returned. Tiles which reach beyond the view are cut at its bounds.
+		constexpr strided_view tile (std::array<std::size_t, N> begins, std::array<std::size_t, N> lengths) const
+		{
+			auto tiled = *this;
+			for (std::size_t dimension = 0; dimension < N; ++dimension)
+			{
+				const auto begin = begins[dimension] < extents[dimension] ? begins[dimension] : extents[dimension];
+				const auto rest = extents[dimension] - begin;
+				tiled.values += begin * strides[dimension];
+				tiled.extents[dimension] = lengths[dimension] < rest ? lengths[dimension] : rest;
+			}
+			return tiled;
+		}
+
+		/// Returns a view on \a rows times \a columns values from \a row and \a column of a
+		/// two-dimensional view
+		constexpr strided_view tile (std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) const
+			requires (N == 2)
+		{
+			return tile({row, column}, {rows, columns});
+		}
+
+		/// Returns the transposed view of a two-dimensional view without moving any value
+		constexpr strided_view transposed () const
+			requires (N == 2)
+		{
+			return strided_view(values, {extents[1], extents[0]}, {strides[1], strides[0]});
+		}
+
+		/// Constant filling
+		///
+		/// All values in the view will be assigned to \a constant. The values are traversed in
+		/// order of memory.
+		template <typename U>
+			requires std::is_convertible<U, T>::value
+		constexpr void fill (U constant) const
+		{
+			static_assert(not std::is_const<T>::value, "Value of strided_view must be not const!");
+
+			auto filler = [&constant](T & value)
+			{
+				value = constant;
+			};
+			visit(filler);
+		}
+
+		/// Transforming
+		///
+		/// All values in the view will be transformed by \a transformer. The values are traversed
+		/// in order of memory.
+		template <Callable<T, T> C>
+		constexpr void transform (C transformer) const
+		{
+			static_assert(not std::is_const<T>::value, "Value of strided_view must be not const!");
+
+			auto assigner = [&transformer](T & value)
+			{
+				value = transformer(std::move(value));
+			};
+			visit(assigner);
+		}
+
+	};
+
+
+	/// Cache-blocked transforming of two-dimensional views
+	///
+	/// Each value of \a destination will be assigned to the transformed value at the same indices
+	/// in \a source. Both views must have the same extents. The views are traversed in square
+	/// tiles which fit into the cache, and each tile is traversed in the order of memory of \a
+	/// destination. So values of both views are taken from the cache, even if their layouts
+	/// differ, e.g. if one of them is transposed.
+	///
+	/// @param source       View whose values are transformed
+	/// @param destination  View to which the transformed values are assigned
+	/// @param transformer  A callable object which takes a constant reference of type \a T and
+	///                     returns a value assignable to \a U
+	///
+	template <typename T, typename U, Callable_<const T&> C>
+	constexpr void transform (strided_view<T, 2> source, strided_view<U, 2> destination, C transformer)
+	{
+		static_assert(not std::is_const<U>::value, "Value of destination must be not const!");
+		assert(source.extent(0) == destination.extent(0));
+		assert(source.extent(1) == destination.extent(1));
+
+		constexpr auto edge = blocking_tile_edge(sizeof(T) > sizeof(U) ? sizeof(T) : sizeof(U));
+		const auto rows = destination.extent(0);
+		const auto columns = destination.extent(1);
+		const auto rowMajor = destination.stride(1) <= destination.stride(0);
+		const T * from = source.data();
+		U * to = destination.data();
+
+		for (std::size_t tileRow = 0; tileRow < rows; tileRow += edge)
+		{
+			const auto rowEnd = tileRow + edge < rows ? tileRow + edge : rows;
+			for (std::size_t tileColumn = 0; tileColumn < columns; tileColumn += edge)
+			{
+				const auto columnEnd = tileColumn + edge < columns ? tileColumn + edge : columns;
+				if (rowMajor)
+				{
+					for (auto row = tileRow; row < rowEnd; ++row)
+						for (auto column = tileColumn; column < columnEnd; ++column)
+							to[row * destination.stride(0) + column * destination.stride(1)] = transformer(from[row * source.stride(0) + column * source.stride(1)]);
+				}
+				else
+				{
+					for (auto column = tileColumn; column < columnEnd; ++column)
+						for (auto row = tileRow; row < rowEnd; ++row)
+							to[row * destination.stride(0) + column * destination.stride(1)] = transformer(from[row * source.stride(0) + column * source.stride(1)]);
+				}
+			}
+		}
+	}
+
+	/// Cache-blocked transposing of two-dimensional views
+	///
+	/// Each value of \a source will be assigned to \a destination with row and column swapped.
+	/// The extents of \a destination must be the swapped extents of \a source. See transform.
+	template <typename T, typename U>
+	constexpr void transpose (strided_view<T, 2> source, strided_view<U, 2> destination)
+	{
+		transform(source, destination.transposed(), [](const T & value) -> const T &
+		{
+			return value;
+		});
+	}
+
+}
+
+#endif
@@ -0,0 +1,184 @@
+/// @file thread_pool.hpp
+/// @author Michael Koch
+/// @copyright CC BY 3.0
+
+#ifndef __STDEXT_THREAD_POOL_HPP__
+#define __STDEXT_THREAD_POOL_HPP__
+
+#include <stdext/callable.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace stdext
+{
+
+	/// Pool of worker threads
+	///
+	/// The pool executes submitted jobs on a fixed amount of threads. The thread which waits for
+	/// the pool takes part in executing jobs, so a pool with \a threadCount threads starts only \a
+	/// threadCount - 1 workers and a pool with one thread executes all jobs while waiting. Jobs may
+	/// submit further jobs to the pool. If jobs throw, the first exception is thrown again by the
+	/// next wait, after all jobs have been executed.
+	class thread_pool
+	{
+
+	private:
+
+		std::unique_ptr<std::thread[]> workers;
+		std::size_t workerCount = 0;
+		std::deque<std::function<void()>> jobs;
+		std::size_t pending = 0;
+		std::exception_ptr exception;
+		bool stopping = false;
+		std::mutex mutex;
+		std::condition_variable jobAvailable;
+		std::condition_variable jobsDone;
+
+
+		/// Executes the next job, if there is any, with the locked \a lock
+		///
+		/// The lock is released while the job is executed and acquired afterwards again. A boolean
+		/// is returned indicating whether a job has been executed.
+		bool execute_next (std::unique_lock<std::mutex> & lock)
+		{
+			if (jobs.empty())
+				return false;
+
+			auto job = std::move(jobs.front());
+			jobs.pop_front();
+			lock.unlock();
+			auto failure = std::exception_ptr();
+			try
+			{
+				job();
+			}
+			catch (...)
+			{
+				failure = std::current_exception();
+			}
+			lock.lock();
+			if (failure and not exception)
+				exception = std::move(failure);
+			if (--pending == 0)
+				jobsDone.notify_all();
+			return true;
+		}
+
+		/// Executes jobs until the pool is destructed
+		void work ()
+		{
+			auto lock = std::unique_lock<std::mutex>(mutex);
+			while (not stopping)
+			{
+				if (not execute_next(lock))
+					jobAvailable.wait(lock);
+			}
+		}
+
+		/// Stops and joins all started workers
+		void stop ()
+		{
+			{
+				auto lock = std::unique_lock<std::mutex>(mutex);
+				stopping = true;
+			}
+			jobAvailable.notify_all();
+			for (std::size_t index = 0; index < workerCount; ++index)
+			{
+				if (workers[index].joinable())
+					workers[index].join();
+			}
+		}
+
+	public:
+
+		/// Constructor with amount of threads
+		///
+		/// The pool will execute jobs on \a threadCount threads including the waiting thread. A
+		/// \a threadCount of zero is treated like one. If a thread cannot be started, the already
+		/// started ones are joined before the exception is passed on.
+		explicit thread_pool (std::size_t threadCount)
+			: workers(new std::thread[threadCount > 1 ? threadCount - 1 : 0]),
+			  workerCount(threadCount > 1 ? threadCount - 1 : 0)
+		{
+			try
+			{
+				for (std::size_t index = 0; index < workerCount; ++index)
+					workers[index] = std::thread([this](){work();});
+			}
+			catch (...)
+			{
+				stop();
+				throw;
+			}
+		}
+
+		thread_pool (const thread_pool &) = delete;
+		thread_pool& operator = (const thread_pool &) = delete;
+
+		/// Destructor
+		///
+		/// All remaining jobs will be executed before the workers are joined. An exception thrown
+		/// by a job which has not been waited for is discarded.
+		~thread_pool ()
+		{
+			try
+			{
+				wait();
+			}
+			catch (...)
+			{}
+			stop();
+		}
+
+		/// Returns the amount of threads executing jobs, including the waiting thread
+		std::size_t thread_count () const
+		{
+			return workerCount + 1;
+		}
+
+		/// Submits \a job for execution
+		///
+		/// The \a job will be executed by some worker or by the waiting thread. The order of
+		/// execution is the order of submission, but jobs may run concurrently.
+		template <Callable_<> C>
+		void submit (C job)
+		{
+			{
+				auto lock = std::unique_lock<std::mutex>(mutex);
+				jobs.emplace_back(std::move(job));
+				++pending;
+			}
+			jobAvailable.notify_one();
+			jobsDone.notify_all();
+		}
+
+		/// Waits until all submitted jobs have been executed
+		///
+		/// The calling thread executes jobs itself while waiting. Jobs submitted by other jobs will
+		/// be waited for as well. If any job has thrown since the last wait, the first exception
+		/// will be thrown again. The method must not be called from within a job.
+		void wait ()
+		{
+			auto lock = std::unique_lock<std::mutex>(mutex);
+			while (pending > 0)
+			{
+				if (not execute_next(lock))
+					jobsDone.wait(lock, [this](){return pending == 0 or not jobs.empty();});
+			}
+			if (exception)
+				std::rethrow_exception(std::exchange(exception, nullptr));
+		}
+
+	};
+
+}
+
+#endif
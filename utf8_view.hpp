@@ -5,6 +5,8 @@
 #ifndef __STDEXT_UTF8_VIEW_HPP__
 #define __STDEXT_UTF8_VIEW_HPP__
 
+#include <array>
+
 namespace stdext
 {
 
@@ -100,6 +102,38 @@ namespace stdext
 			return value;
 		}
 
+		/// Chunked folding
+		///
+		/// The characters are decoded into a buffer of at most \a sequenceChunkLength characters,
+		/// and each filled buffer is folded over \a value by \a combiner as an array view. Runs of
+		/// ASCII characters are widened in a tight loop without decoding.
+		template <typename V, Callable<V, V, array_view<const char32_t>> C>
+		constexpr V fold_chunks (C combiner, V value) const
+		{
+			auto buffer = std::array<char32_t, sequenceChunkLength>();
+			const unsigned char * bytes = encoding.data();
+			const auto length = encoding.length();
+			std::size_t index = 0;
+			while (index < length)
+			{
+				std::size_t count = 0;
+				while (count < sequenceChunkLength and index < length)
+				{
+					const auto asciiEnd = length - index < sequenceChunkLength - count ? length : index + sequenceChunkLength - count;
+					while (index < asciiEnd and bytes[index] < 0x80)
+						buffer[count++] = bytes[index++];
+					if (count < sequenceChunkLength and index < length and bytes[index] >= 0x80)
+					{
+						const auto decoding = decode(bytes + index);
+						buffer[count++] = std::get<0>(decoding);
+						index += std::get<1>(decoding);
+					}
+				}
+				value = combiner(std::move(value), array_view<const char32_t>(buffer.data(), count));
+			}
+			return value;
+		}
+
 		template <typename V, Callable<V, V, char32_t> C>
 		constexpr V fold_reverse (C combiner, V value) const
 		{